@@ -0,0 +1,71 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+
+import math
+l0 = 2.0*math.pi	# wavelength in normalized units
+t0 = l0				# optical cycle in normalized units
+Lsim = 160.*l0		# simulation length
+Tsim = 20.*t0		# duration of the simulation
+
+Main(
+    geometry = "1d3v",
+    
+    interpolation_order = 2,
+    
+    cell_length = [5.*l0],
+    sim_length  = [Lsim],
+    
+    number_of_patches = [ 4 ],
+    
+    timestep = 0.1*t0,
+    sim_time = Tsim,
+    
+    time_fields_frozen = 2.*Tsim,
+    solve_poisson = False,
+    
+    bc_em_type_x = ['periodic'],
+    
+    referenceAngularFrequency_SI = l0*3e8/1.e-6,
+    
+    random_seed = 0
+)
+
+E = 1000./511.		# electron energy (1 MeV)
+Species(
+	species_type = 'electron',
+	initPosition_type = 'regular',
+	initMomentum_type = 'maxwell-juettner',
+	n_part_per_cell = 100,
+	mass = 1.0,
+	charge = -1.0,
+	nb_density = 10.,
+	mean_velocity = [math.sqrt(1.-1./(1.+E)**2), 0., 0.],
+	temperature = [1e-10]*3,
+	time_frozen = 2.*Tsim,
+	c_part_max = 10.,
+	bc_part_type_xmin = 'none',
+	bc_part_type_xmax = 'none'
+)
+Species(
+	species_type = 'ion',
+	initPosition_type = 'regular',
+	initMomentum_type = 'cold',
+	n_part_per_cell = 100,
+	mass = 1836.0*27.,
+	charge = 0.,
+	atomic_number = 13,
+	nb_density = 10.,
+	time_frozen = 2.*Tsim,
+	bc_part_type_xmin = 'none',
+	bc_part_type_xmax = 'none'
+)
+
+Collisions(
+	species1 = ['electron'],
+	species2 = ['ion'],
+	coulomb_log = 1e-8,
+	ionizing = True
+)
+
+DiagScalar(every = 10)
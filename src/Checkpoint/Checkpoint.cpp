@@ -167,6 +167,7 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
     
     H5::attr(fid, "dump_step", itime);
     H5::attr(fid, "dump_number", dump_number);
+    H5::attr(fid, "random_seed", params.random_seed);
     
     H5::vect( fid, "patch_count", smpi->patch_count );
     
@@ -196,6 +197,8 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
         hid_t patch_gid = H5::group(fid, patchName.c_str());
         
         dumpPatch( vecPatches(ipatch)->EMfields, vecPatches(ipatch)->vecSpecies, patch_gid );
+        for (unsigned int icoll=0 ; icoll<vecPatches(ipatch)->vecCollisions.size(); icoll++)
+            vecPatches(ipatch)->vecCollisions[icoll]->dumpInterval( patch_gid );
         
         // Close a group
         H5Gclose(patch_gid);
@@ -290,20 +293,20 @@ void Checkpoint::dumpPatch( ElectroMagn* EMfields, std::vector<Species*> vecSpec
             for (unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++) {
                 ostringstream my_name("");
                 my_name << "Position-" << i;
-                H5::vect(gid,my_name.str(), vecSpecies[ispec]->particles->Position[i], dump_deflate);
+                H5::vect(gid,my_name.str(), vecSpecies[ispec]->particles->Position[i][0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_DOUBLE, dump_deflate);
             }
             
             for (unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++) {
                 ostringstream my_name("");
                 my_name << "Momentum-" << i;
-                H5::vect(gid,my_name.str(), vecSpecies[ispec]->particles->Momentum[i], dump_deflate);
+                H5::vect(gid,my_name.str(), vecSpecies[ispec]->particles->Momentum[i][0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_PARTICLE_REAL, dump_deflate);
             }
             
-            H5::vect(gid,"Weight", vecSpecies[ispec]->particles->Weight, dump_deflate);
-            H5::vect(gid,"Charge", vecSpecies[ispec]->particles->Charge, dump_deflate);
+            H5::vect(gid,"Weight", vecSpecies[ispec]->particles->Weight[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_PARTICLE_REAL, dump_deflate);
+            H5::vect(gid,"Charge", vecSpecies[ispec]->particles->Charge[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_SHORT, dump_deflate);
             
             if (vecSpecies[ispec]->particles->tracked) {
-                H5::vect(gid,"Id", vecSpecies[ispec]->particles->Id, dump_deflate);
+                H5::vect(gid,"Id", vecSpecies[ispec]->particles->Id[0], vecSpecies[ispec]->particles->size(), H5T_NATIVE_UINT, dump_deflate);
             }
             
             
@@ -375,6 +378,13 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI* smpi, SimWindo
         vector<int> patch_count(smpi->getSize());
         H5::getVect( fid, "patch_count", patch_count );
         smpi->patch_count = patch_count;
+        // The seed of the dumped run (it may come from the clock) keys the random numbers of the patches
+        // Older checkpoints have none: the seed of the namelist (or of the clock) is kept
+        if (H5Aexists(fid, "random_seed")>0) {
+            H5::getAttr(fid, "random_seed", params.random_seed);
+        } else if (smpi->isMaster()) {
+            WARNING("No random_seed in the restart file: the random numbers will differ from the dumped run (using seed " << params.random_seed << ")");
+        }
         vecPatches = PatchesFactory::createVector(params, smpi);
         
         H5::getAttr(fid, "Energy_time_zero",  static_cast<DiagnosticScalar*>(vecPatches.globalDiags[0])->Energy_time_zero );
@@ -402,6 +412,8 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI* smpi, SimWindo
             hid_t patch_gid = H5Gopen(fid, patchName.c_str(),H5P_DEFAULT);
             
             restartPatch( vecPatches(ipatch)->EMfields, vecPatches(ipatch)->vecSpecies, params, patch_gid );
+            for (unsigned int icoll=0 ; icoll<vecPatches(ipatch)->vecCollisions.size(); icoll++)
+                vecPatches(ipatch)->vecCollisions[icoll]->restartInterval( patch_gid );
             
             H5Gclose(patch_gid);
             
@@ -507,21 +519,21 @@ void Checkpoint::restartPatch( ElectroMagn* EMfields,std::vector<Species*> &vecS
             for (unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++) {
                 ostringstream namePos("");
                 namePos << "Position-" << i;
-                H5::getVect(gid,namePos.str(),vecSpecies[ispec]->particles->Position[i]);
+                H5::getVect(gid,namePos.str(),vecSpecies[ispec]->particles->Position[i], H5T_NATIVE_DOUBLE);
             }
             
             for (unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++) {
                 ostringstream namePos("");
                 namePos << "Momentum-" << i;
-                H5::getVect(gid,namePos.str(),vecSpecies[ispec]->particles->Momentum[i]);
+                H5::getVect(gid,namePos.str(),vecSpecies[ispec]->particles->Momentum[i], H5T_NATIVE_PARTICLE_REAL);
             }
             
-            H5::getVect(gid,"Weight",vecSpecies[ispec]->particles->Weight);
+            H5::getVect(gid,"Weight",vecSpecies[ispec]->particles->Weight, H5T_NATIVE_PARTICLE_REAL);
             
-            H5::getVect(gid,"Charge",vecSpecies[ispec]->particles->Charge);
+            H5::getVect(gid,"Charge",vecSpecies[ispec]->particles->Charge, H5T_NATIVE_SHORT);
             
             if (vecSpecies[ispec]->particles->tracked) {
-                H5::getVect(gid,"Id",vecSpecies[ispec]->particles->Id);
+                H5::getVect(gid,"Id",vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT);
             }
             
             H5::getVect(gid,"bmin",vecSpecies[ispec]->bmin,true);
@@ -538,8 +550,8 @@ void Checkpoint::dumpFieldsPerProc(hid_t fid, Field* field)
 {
     hsize_t dims[1]={field->globalDims_};
     hid_t sid = H5Screate_simple (1, dims, NULL);
-    hid_t did = H5Dcreate (fid, field->name.c_str(), H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT,H5P_DEFAULT,H5P_DEFAULT);
-    H5Dwrite(did, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &field->data_[0]);
+    hid_t did = H5Dcreate (fid, field->name.c_str(), H5T_NATIVE_FIELD_REAL, sid, H5P_DEFAULT,H5P_DEFAULT,H5P_DEFAULT);
+    H5Dwrite(did, H5T_NATIVE_FIELD_REAL, H5S_ALL, H5S_ALL, H5P_DEFAULT, &field->data_[0]);
     H5Dclose (did);
     H5Sclose(sid);
 }
@@ -549,7 +561,7 @@ void Checkpoint::restartFieldsPerProc(hid_t fid, Field* field)
     hsize_t dims[1]={field->globalDims_};
     hid_t sid = H5Screate_simple (1, dims, NULL);
     hid_t did = H5Dopen (fid, field->name.c_str(),H5P_DEFAULT);
-    H5Dread(did, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &field->data_[0]);
+    H5Dread(did, H5T_NATIVE_FIELD_REAL, H5S_ALL, H5S_ALL, H5P_DEFAULT, &field->data_[0]);
     H5Dclose (did);
     H5Sclose(sid);
 }
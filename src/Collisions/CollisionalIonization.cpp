@@ -7,13 +7,11 @@
 
 using namespace std;
 
-// Coefficients used for energy interpolation
-// The list of energies has to be in logarithmic scale,
-//  with Emin=1eV, Emax=10MeV and npoints=100.
-const int    CollisionalIonization::npoints = 100;
-const double CollisionalIonization::npointsm1 = (double)(npoints-1);
-const double CollisionalIonization::a1 = 510998.9 ; // = me*c^2/Emin
-const double CollisionalIonization::a2 = 6.142165 ; // = (npoints-1) / ln( Emax/Emin )
+// Sampling of the energies in the tables
+const int CollisionalIonization::exponent_min;
+const int CollisionalIonization::exponent_max;
+const int CollisionalIonization::mantissa_bits;
+const int CollisionalIonization::npoints;
 
 // Constructor
 CollisionalIonization::CollisionalIonization(int Z, int nDim_, double referenceAngularFrequency_SI)
@@ -48,9 +46,8 @@ CollisionalIonization::CollisionalIonization(CollisionalIonization* CI)
 
 // Static members
 vector<int> CollisionalIonization::DB_Z;
-vector<vector<vector<double> > > CollisionalIonization::DB_crossSection;
-vector<vector<vector<double> > > CollisionalIonization::DB_transferredEnergy;
-vector<vector<vector<double> > > CollisionalIonization::DB_lostEnergy;
+vector<vector<double> > CollisionalIonization::DB_table;
+vector<vector<double> > CollisionalIonization::DB_threshold;
 
 // Initializes the databases (by patch master only)
 unsigned int CollisionalIonization::createDatabase(double referenceAngularFrequency_SI)
@@ -63,21 +60,18 @@ unsigned int CollisionalIonization::createDatabase(double referenceAngularFreque
     // Otherwise, create the arrays:
     // For each ionization state, calculate the tables of integrated cross-sections
     // Pérez et al., Phys. Plasmas 19, 083104 (2012)
-    vector<vector<double> > cs; // cross section
-    vector<vector<double> > te; // transferred energy
-    vector<vector<double> > le; // lost energy
-    cs.resize(atomic_number);
-    te.resize(atomic_number);
-    le.resize(atomic_number);
+    vector<double> tab( 3*atomic_number*npoints, 0. ); // cross section, transferred energy, lost energy
+    vector<double> thr( atomic_number, 0. ); // energy above which the cross section is non-zero
     double e, ep, bp, up, ep2, betae2, betab2, betau2, s0, A1, A2, A3, sk, wk, ek;
+    double *cs, *te, *le;
     int N; // occupation number
     double coeff = 2.81794e-15 * referenceAngularFrequency_SI / (2.*299792458.); // r_e omega / 2c
     for( Zstar=0; Zstar<atomic_number; Zstar++ ) { // For each ionization state
-        cs[Zstar].resize(npoints, 0.);
-        te[Zstar].resize(npoints, 0.);
-        le[Zstar].resize(npoints, 0.);
         for( int i=0; i<npoints; i++) { // For each incident electron energy
-            ep = exp( double(i)/a2 ) / a1; // = incident electron energy
+            ep = ldexp( 1. + (double)(i%(1<<mantissa_bits))/(double)(1<<mantissa_bits), exponent_min + (i>>mantissa_bits) ); // = incident electron energy
+            cs = &tab[3*(Zstar*npoints+i)  ];
+            te = &tab[3*(Zstar*npoints+i)+1];
+            le = &tab[3*(Zstar*npoints+i)+2];
             N = 1;
             for( int k=0; k<atomic_number-Zstar; k++ ) { // For each orbital
                 bp = IonizationTables::binding_energy(atomic_number, Zstar, k);
@@ -105,26 +99,28 @@ unsigned int CollisionalIonization::createDatabase(double referenceAngularFreque
                                 + 0.25*A2*(e-1.) - A1*(e*log(e)-(e+1.)*log(0.5*(e+1.))) );
                     ek = wk + sk;
                     // Sum these data to the total ones
-                    cs[Zstar][i] += sk;
-                    te[Zstar][i] += wk * bp;
-                    le[Zstar][i] += ek * bp;
+                    *cs += sk;
+                    *te += wk * bp;
+                    *le += ek * bp;
                 }
                 // Reset occupation number for next level
                 N = 1;
             }
             // The transferred and lost energies are averages over the orbitals
-            if( cs[Zstar][i]>0. ) { 
-                te[Zstar][i] /= cs[Zstar][i];
-                le[Zstar][i] /= cs[Zstar][i];
+            if( *cs>0. ) { 
+                *te /= *cs;
+                *le /= *cs;
+            } else {
+                // The interpolated cross section is non-zero above the last point where it is zero
+                thr[Zstar] = ep;
             }
         }
     }
     
     // Add the new arrays to the static database
-    DB_Z                .push_back( atomic_number );
-    DB_crossSection     .push_back( cs            );
-    DB_transferredEnergy.push_back( te            );
-    DB_lostEnergy       .push_back( le            );
+    DB_Z        .push_back( atomic_number );
+    DB_table    .push_back( tab           );
+    DB_threshold.push_back( thr           );
     
     return DB_Z.size()-1;
 }
@@ -134,9 +130,9 @@ unsigned int CollisionalIonization::createDatabase(double referenceAngularFreque
 void CollisionalIonization::assignDatabase(unsigned int index)
 {
 
-    crossSection      = &(DB_crossSection     [index]);
-    transferredEnergy = &(DB_transferredEnergy[index]);
-    lostEnergy        = &(DB_lostEnergy       [index]);
+    // (the arrays of the database do not move when other atomic numbers are added)
+    table     = DB_table    [index].data();
+    threshold = DB_threshold[index].data();
 
 }
 
@@ -146,9 +142,8 @@ void CollisionalIonization::assignDatabase(unsigned int index)
 void CollisionalIonization::prepare2(Particles *p1, int i1, Particles *p2, int i2,
     bool not_duplicated_particle)
 {
-    static double E; // electron energy
-    static double We, Wi; // weights
-    static double cs, x;
+    double E; // electron energy
+    double We, Wi; // weights
     // Calculates the current electron energy, the ion charge and weight
     if( electronFirst ) {
         E = sqrt(1. + pow(p1->momentum(0,i1),2)+pow(p1->momentum(1,i1),2)+pow(p1->momentum(2,i1),2))-1.;
@@ -165,13 +160,8 @@ void CollisionalIonization::prepare2(Particles *p1, int i1, Particles *p2, int i
         ERROR("Collisional ionization requires positively charged ions");
     // No ionization if fully ionized already
     if( Zstar>=atomic_number ) return;
-    // Retrieve the cross section from the database
-    x = a2*log(a1*E); // index in the database, which depends on the electron energy E
-    if( x<0. ) x = 0.;
-    else if( x>npointsm1 ) x = npointsm1;
-    cs = (*crossSection)[Zstar][ int(x) ];
     // Calculate hybrid density nei
-    if( cs>0. ) { // only pairs that can ionize
+    if( E>threshold[Zstar] ) { // only pairs that can ionize (non-zero cross section)
         if( electronFirst ) {
             We = p1->weight(i1);
             ne += We;
@@ -184,20 +174,20 @@ void CollisionalIonization::prepare2(Particles *p1, int i1, Particles *p2, int i
 }
 
 // Method to prepare the ionization
-void CollisionalIonization::prepare3(double timestep, int n_patch_per_cell)
+void CollisionalIonization::prepare3(double timestep)
 {
-    // Calculate the coeff used later for ionization probability
+    // Calculate the coeff used later for ionization probability (densities of the cell)
     if( nei<=0. ) {
         coeff = 0.;
     } else {
-        coeff = ne*ni/nei * timestep * n_patch_per_cell;
+        coeff = ne*ni/nei * timestep;
     }
 }
 
 // Method to apply the ionization
-void CollisionalIonization::apply(Particles *p1, int i1, Particles *p2, int i2)
+void CollisionalIonization::apply(Particles *p1, int i1, Particles *p2, int i2, Random &random)
 {
-    static double gamma_s, gamma1, gamma2;
+    double gamma_s, gamma1, gamma2;
     gamma1 = p1->lor_fac(i1);
     gamma2 = p2->lor_fac(i2);
     // Calculate lorentz factor in the frame of ion
@@ -207,20 +197,20 @@ void CollisionalIonization::apply(Particles *p1, int i1, Particles *p2, int i2)
         - p1->momentum(2,i1)*p2->momentum(2,i2);
     // Calculate the rest of the stuff
     if( electronFirst ) {
-        calculate(gamma_s, gamma1, gamma2, p1, i1, p2, i2);
+        calculate(gamma_s, gamma1, gamma2, p1, i1, p2, i2, random);
     } else {
-        calculate(gamma_s, gamma2, gamma1, p2, i2, p1, i1);
+        calculate(gamma_s, gamma2, gamma1, p2, i2, p1, i1, random);
     }
 }
 
 // Method used by ::apply so that we are sure that electrons are the first species
 void CollisionalIonization::calculate(double gamma_s, double gammae, double gammai, 
-    Particles *pe, int ie, Particles *pi, int ii)
+    Particles *pe, int ie, Particles *pi, int ii, Random &random)
 {
-    static double We, Wi; // weights
-    static double U1, U2; // random number
-    static double a, x, cs, w, e, pr, p2, WeWi, WiWe, cum_prob, cp;
-    static int i, j, k, p, kmax;
+    double We, Wi; // weights
+    double U1, U2; // random number
+    double cs, w, e, pr, p2, WeWi, WiWe, cum_prob, cp;
+    int j, k, p, kmax;
     
     // Get ion charge
     Zstar = pi->charge(ii);
@@ -236,29 +226,14 @@ void CollisionalIonization::calculate(double gamma_s, double gammae, double gamm
     WiWe = 1./WeWi;
     
     // Make a random number to choose if ionization or not
-    U1 = (double)rand() / RAND_MAX;
+    U1 = random.uniform();
     
     // Loop for multiple ionization
     // k+1 is the number of ionizations
     kmax = atomic_number-Zstar-1;
     for( k = 0; k <= kmax;  k++ ) {
-        // Calculate the location x (~log of energy) in the databases
-        x = a2*log(a1*(gamma_s-1.));
-        
-        // Interpolate the databases at location x
-        if( x<0. ) break; // if energy below Emin, do nothing
-        if( x<npointsm1 ) { // if energy within table range, interpolate
-            i = int(x);
-            a = x - (double)i;
-            cs = ((*crossSection     )[Zstar][i+1]-(*crossSection     )[Zstar][i])*a + (*crossSection     )[Zstar][i];
-            w  = ((*transferredEnergy)[Zstar][i+1]-(*transferredEnergy)[Zstar][i])*a + (*transferredEnergy)[Zstar][i];
-            e  = ((*lostEnergy       )[Zstar][i+1]-(*lostEnergy       )[Zstar][i])*a + (*lostEnergy       )[Zstar][i];
-        } else { // if energy above table range, extrapolate
-            a = x - npointsm1;
-            cs = ((*crossSection)[Zstar][npointsm1]-(*crossSection)[Zstar][npointsm1-1])*a + (*crossSection)[Zstar][npointsm1];
-            w  =  (*transferredEnergy)[Zstar][npointsm1];
-            e  =  (*lostEnergy       )[Zstar][npointsm1];
-        }
+        // Interpolate the databases at the energy of the electron in the ion frame
+        if( !interpolate(Zstar, gamma_s-1., cs, w, e) ) break; // if energy below the tables, do nothing
         if( e > gamma_s-1. ) break;
         
         rate[k] = K*cs/gammae  ; // k-th ionization rate
@@ -288,7 +263,7 @@ void CollisionalIonization::calculate(double gamma_s, double gammae, double gamm
         if( U1 < cum_prob ) break;
         
         // Otherwise, we do the ionization
-        U2 = (double)rand() / RAND_MAX;
+        U2 = random.uniform();
         p2 = gamma_s*gamma_s - 1.;
         // Ionize the atom and create electron
         if( U2 < WeWi ) {
@@ -338,17 +313,6 @@ void CollisionalIonization::finish(Species *s1, Species *s2, Params &params, Pat
     if( electronFirst ) {electron_species = s1;}
     else {electron_species = s2;}
     
-    for (unsigned int i=0; i < new_electrons.size(); i++) {
-        
-        unsigned int ibin = (int) (new_electrons.position(0,i) / params.cell_length[0]) - ( patch->getCellStartingGlobalIndex(0) + params.oversize[0] );
-        new_electrons.cp_particle(i, *(electron_species->particles), electron_species->bmin[ibin] );
-        
-        electron_species->bmax[ibin]++;
-        for (unsigned int ii=ibin+1; ii<electron_species->bmin.size(); ii++) {
-            electron_species->bmin[ii]++;
-            electron_species->bmax[ii]++;
-        }
-    }
-    new_electrons.clear();
+    electron_species->insertParticlesInBins( new_electrons, patch );
 }
 
@@ -3,10 +3,13 @@
 #define COLLISIONALIONIZATION_H
 
 #include <vector>
+#include <cstring>
+#include <stdint.h>
 
 #include "Tools.h"
 #include "Species.h"
 #include "Params.h"
+#include "Random.h"
 
 class Patch;
 
@@ -29,9 +32,13 @@ public:
     //! Gets the k-th binding energy of any neutral or ionized atom with atomic number Z and charge Zstar
     double binding_energy(int Zstar, int k);
     
-    //! Coefficients used for interpolating the energy over a given initial list
-    static const double a1, a2, npointsm1;
-    static const int npoints;
+    //! The tables are sampled at the kinetic energies E = 2^exponent * ( 1 + m/2^mantissa_bits ) (in units of me*c^2),
+    //! with exponent_min <= exponent < exponent_max, so that the index of E is read from its bits (no logarithm)
+    //! (1eV to 16MeV, with 16 points per power of 2)
+    static const int exponent_min  = -19;
+    static const int exponent_max  = 5;
+    static const int mantissa_bits = 4;
+    static const int npoints = ( (exponent_max-exponent_min) << mantissa_bits ) + 1;
     
     //! Methods to prepare the ionization
     inline void prepare1(int Z_firstgroup) {
@@ -39,18 +46,17 @@ public:
         ne = 0.; ni = 0.; nei = 0.;
         };
     virtual void prepare2(Particles *p1, int i1, Particles *p2, int i2, bool);
-    virtual void prepare3(double, int);
-    //! Method to apply the ionization
-    virtual void apply(Particles *p1, int i1, Particles *p2, int i2);
+    virtual void prepare3(double);
+    //! Method to apply the ionization (random numbers drawn from the stream of the collisions)
+    virtual void apply(Particles *p1, int i1, Particles *p2, int i2, Random &random);
     //! Method to finish the ionization and put new electrons in place
     virtual void finish(Species *s1, Species *s2, Params&, Patch*);
     
-    //! Local table of integrated cross-section
-    std::vector<std::vector<double> > * crossSection;
-    //! Local table of average secondary electron energy
-    std::vector<std::vector<double> > * transferredEnergy;
-    //! Local table of average incident electron energy lost
-    std::vector<std::vector<double> > * lostEnergy;
+    //! Local table of integrated cross-section, average secondary electron energy and average incident electron
+    //! energy lost, interleaved: the 3 values of charge state Zstar at point i are at table[3*(Zstar*npoints+i)]
+    const double * table;
+    //! Local table of the energy above which the cross-section is non-zero, for each charge state
+    const double * threshold;
     
     //! New electrons temporary species
     Particles new_electrons;
@@ -68,12 +74,36 @@ private:
     
     //! Global table of atomic numbers
     static std::vector<int> DB_Z;
-    //! Global table of integrated cross-section
-    static std::vector<std::vector<std::vector<double> > > DB_crossSection;
-    //! Global table of average secondary electron energy
-    static std::vector<std::vector<std::vector<double> > > DB_transferredEnergy;
-    //! Global table of average incident electron energy lost
-    static std::vector<std::vector<std::vector<double> > > DB_lostEnergy;
+    //! Global table of integrated cross-section, average secondary electron energy and average incident electron
+    //! energy lost (one interleaved table per atomic number)
+    static std::vector<std::vector<double> > DB_table;
+    //! Global table of the energies above which the cross-sections are non-zero
+    static std::vector<std::vector<double> > DB_threshold;
+    
+    //! Interpolate the cross-section cs, transferred energy w and lost energy e of the charge state Zstar
+    //! at kinetic energy E (returns false if E is below the tables)
+    inline bool interpolate(int Zstar, double E, double &cs, double &w, double &e) {
+        uint64_t bits;
+        memcpy( &bits, &E, sizeof(bits) );
+        int exponent = (int)( bits >> 52 ) - 1023;
+        if( exponent < exponent_min ) return false;
+        const double * t = &table[3*Zstar*npoints];
+        if( exponent >= exponent_max ) { // above the tables, the cross-section is extrapolated linearly in log(E)
+            t += 3*(npoints-1);
+            cs = t[0] + (t[0]-t[-3]) * log( ldexp(E, -exponent_max) ) / log( (double)(2<<mantissa_bits)/(double)((2<<mantissa_bits)-1) );
+            w  = t[1];
+            e  = t[2];
+            return true;
+        }
+        uint64_t mantissa = bits & 0xFFFFFFFFFFFFFull;
+        int i = ( (exponent-exponent_min) << mantissa_bits ) + (int)( mantissa >> (52-mantissa_bits) );
+        double a = (double)( mantissa & ( (1ull<<(52-mantissa_bits)) - 1 ) ) / (double)( 1ull<<(52-mantissa_bits) );
+        t += 3*i;
+        cs = t[0] + a*(t[3]-t[0]);
+        w  = t[1] + a*(t[4]-t[1]);
+        e  = t[2] + a*(t[5]-t[2]);
+        return true;
+    }
     
     //! True if first group of species is the electron
     bool electronFirst;
@@ -93,7 +123,7 @@ private:
     std::vector<double> prob;
     
     //! Method called by ::apply to calculate the ionization, being sure that electrons are the first species
-    void calculate(double, double, double, Particles *pe, int ie, Particles *pi, int ii);
+    void calculate(double, double, double, Particles *pe, int ie, Particles *pi, int ii, Random &random);
     
     //! Quantities used during computation
     int Zstar; // ion charge
@@ -111,8 +141,8 @@ public:
     virtual void assignDatabase(unsigned int) {};
     
     void prepare2(Particles*, int, Particles*, int, bool){};
-    void prepare3(double, int){};
-    void apply(Particles*, int, Particles*, int){};
+    void prepare3(double){};
+    void apply(Particles*, int, Particles*, int, Random&){};
     void finish(Species*, Species*, Params&, Patch*) {};
 };
 
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <ostream>
 #include <fstream>
+#include <limits>
 
 #include "Collisions.h"
 #include "SmileiMPI.h"
@@ -11,6 +12,7 @@
 #include "H5.h"
 #include "Patch.h"
 #include "VectorPatch.h"
+#include "tabulatedFunctions.h"
 
 using namespace std;
 
@@ -23,6 +25,8 @@ Collisions::Collisions(
     vector<unsigned int> species_group2, 
     double coulomb_log, 
     bool intra_collisions,
+    int every,
+    double adaptive_s,
     int debug_every,
     int Z,
     bool ionizing,
@@ -36,6 +40,13 @@ species_group2  (species_group2  ),
 coulomb_log     (coulomb_log     ),
 intra_collisions(intra_collisions),
 debug_every     (debug_every     ),
+every           (every           ),
+adaptive_s      (adaptive_s      ),
+elapsed         (0               ),
+frequency       (numeric_limits<double>::max()),
+interval_request(MPI_REQUEST_NULL),
+applied         (false           ),
+interval        (0.              ),
 atomic_number   (Z               ),
 filename(filename)
 {
@@ -59,6 +70,13 @@ Collisions::Collisions( Collisions* coll, int nDim )
     coulomb_log      = coll->coulomb_log     ;
     intra_collisions = coll->intra_collisions;
     debug_every      = coll->debug_every     ;
+    every            = coll->every           ;
+    adaptive_s       = coll->adaptive_s      ;
+    elapsed          = coll->elapsed         ;
+    frequency        = coll->frequency       ;
+    interval_request = MPI_REQUEST_NULL      ;
+    applied          = false                 ;
+    interval         = 0.                    ;
     atomic_number    = coll->atomic_number   ;
     filename         = coll->filename        ;
     
@@ -72,6 +90,9 @@ Collisions::Collisions( Collisions* coll, int nDim )
 
 Collisions::~Collisions()
 {
+    // The patch may have been sent to another process: its buffer must outlive the send
+    if( interval_request != MPI_REQUEST_NULL )
+        MPI_Wait( &interval_request, MPI_STATUS_IGNORE );
     delete Ionization;
 }
 
@@ -90,6 +111,7 @@ void Collisions::calculate_debye_length(Params& params, Patch * patch)
     Species   * s;
     Particles * p;
     double coeff = 299792458./(3.*params.referenceAngularFrequency_SI*2.8179403267e-15); // c / (3 omega re)
+    vector<double> densities(nspec, 0.), charges(nspec, 0.), temperatures(nspec, 0.);
     
     density_max = 0.;
     patch->debye_length_squared = 0.;
@@ -114,6 +136,7 @@ void Collisions::calculate_debye_length(Params& params, Patch * patch)
         charge /= density; // average charge
         temperature *= (s->mass) / (3.*density); // Te in units of me*c^2
         density /= (double)params.n_cell_per_patch; // density in units of critical density
+        densities[ispec] = density; charges[ispec] = charge; temperatures[ispec] = temperature;
         // compute inverse debye length squared
         if (temperature>0.) patch->debye_length_squared += density*charge*charge/temperature;
         // compute maximum density of species
@@ -129,6 +152,11 @@ void Collisions::calculate_debye_length(Params& params, Patch * patch)
         if (patch->debye_length_squared < rmin2) patch->debye_length_squared = rmin2;
     }
     
+    // collision frequencies for the adaptive intervals
+    for (unsigned int icoll=0 ; icoll<patch->vecCollisions.size() ; icoll++)
+        if (patch->vecCollisions[icoll]->adaptive_s > 0.)
+            patch->vecCollisions[icoll]->calculate_frequency(params, patch, densities, charges, temperatures);
+    
 #ifdef  __DEBUG
     // calculate and print average debye length
     double mean_debye_length = sqrt(patch->debye_length_squared);
@@ -139,14 +167,116 @@ void Collisions::calculate_debye_length(Params& params, Patch * patch)
 
 }
 
+// Estimates the collision frequency in a patch: the largest frequency at which the particles of one species
+// are deflected by another species of the other group (in the non-relativistic limit of the collision parameter s
+// computed in collide, the relative velocity being the thermal one)
+void Collisions::calculate_frequency(Params& params, Patch* patch, vector<double> &density, vector<double> &charge,
+                                     vector<double> &temperature)
+{
+    double coeff1 = 4.046650232e-21*params.referenceAngularFrequency_SI; // h*omega/(2*me*c^2)
+    double coeff2 = 2.817940327e-15*params.referenceAngularFrequency_SI/299792458.; // re omega / c
+    double mi, mj, mij, qqm, vrel2, vrel, p_COM, bmin, logL, nu;
+    
+    frequency = 0.;
+    for (unsigned int g=0; g<2; g++) { // particles of group 1 deflected by group 2, then the opposite
+        vector<unsigned int> &gi = g==0 ? species_group1 : species_group2;
+        vector<unsigned int> &gj = g==0 ? species_group2 : species_group1;
+        for (unsigned int i=0; i<gi.size(); i++) {
+            nu = 0.;
+            for (unsigned int j=0; j<gj.size(); j++) {
+                if (density[gi[i]]<=0. || density[gj[j]]<=0.) continue;
+                mi  = patch->vecSpecies[gi[i]]->mass;
+                mj  = patch->vecSpecies[gj[j]]->mass;
+                mij = mi/mj;
+                qqm = charge[gi[i]]*charge[gj[j]]/mi;
+                vrel2 = 3.*( temperature[gi[i]]/mi + temperature[gj[j]]/mj );
+                if (vrel2 <= 0.) { // cold plasma: collide every timestep
+                    frequency = numeric_limits<double>::max();
+                    return;
+                }
+                vrel  = sqrt( min(vrel2, 1.) );
+                p_COM = vrel/(1.+mij);
+                logL = coulomb_log;
+                if( logL <= 0. ) {
+                    bmin = max( coeff1/mi/p_COM , abs(coeff2*qqm)/(p_COM*p_COM) );
+                    logL = coulomb_logarithm::instance().call( patch->debye_length_squared/(bmin*bmin) );
+                }
+                nu += coeff2 * logL * qqm*qqm * density[gj[j]] / (p_COM*p_COM*p_COM);
+            }
+            if (nu > frequency) frequency = nu;
+        }
+        if (intra_collisions) break;
+    }
+}
+
+// Decides whether the collisions are applied at this timestep, and the time elapsed since the last ones.
+// Collisions are applied every `every` timesteps, with a timestep multiplied accordingly.
+// With the adaptive interval, they wait until the collision parameter accumulated in the patch since the last
+// collisions reaches adaptive_s, the frequency being the one estimated at the last collisions
+// (patches with negligible collisionality skip the sort, the pairing and the Debye length for up to `every` timesteps)
+bool Collisions::isApplied(Params& params, int itime)
+{
+    if( adaptive_s > 0. ) {
+        elapsed++;
+        applied  = ( elapsed >= every || frequency * elapsed * params.timestep >= adaptive_s );
+        interval = elapsed * params.timestep;
+        if( applied ) elapsed = 0;
+    } else {
+        applied  = ( itime % every == 0 );
+        interval = every * params.timestep;
+    }
+    return applied;
+}
+
+// Stores the state of the adaptive interval in the checkpoint group of the patch
+void Collisions::dumpInterval(hid_t patch_gid)
+{
+    if( adaptive_s <= 0. ) return;
+    ostringstream name("");
+    name << "Collisions" << n_collisions;
+    H5::attr(patch_gid, name.str()+"-elapsed"  , elapsed  );
+    H5::attr(patch_gid, name.str()+"-frequency", frequency);
+}
+
+// Reads the state of the adaptive interval from the checkpoint group of the patch
+void Collisions::restartInterval(hid_t patch_gid)
+{
+    if( adaptive_s <= 0. ) return;
+    ostringstream name("");
+    name << "Collisions" << n_collisions;
+    H5::getAttr(patch_gid, name.str()+"-elapsed"  , elapsed  );
+    H5::getAttr(patch_gid, name.str()+"-frequency", frequency);
+}
+
+// Sends the state of the adaptive interval with the patch, when it moves to another process
+void Collisions::isendInterval(int to, int tag)
+{
+    if( adaptive_s <= 0. ) return;
+    interval_send[0] = elapsed;
+    interval_send[1] = frequency;
+    MPI_Isend( interval_send, 2, MPI_DOUBLE, to, tag, MPI_COMM_WORLD, &interval_request );
+}
+
+// Receives the state of the adaptive interval of a patch coming from another process
+void Collisions::recvInterval(int from, int tag)
+{
+    if( adaptive_s <= 0. ) return;
+    double interval_recv[2];
+    MPI_Status status;
+    MPI_Recv( interval_recv, 2, MPI_DOUBLE, from, tag, MPI_COMM_WORLD, &status );
+    elapsed   = (int) interval_recv[0];
+    frequency = interval_recv[1];
+}
+
 // Calculates the collisions for a given Collisions object
 void Collisions::collide(Params& params, Patch* patch, int itime)
 {
 
     vector<unsigned int> *sg1, *sg2, *sgtmp, index1, index2;
     unsigned int nspec1, nspec2; // numbers of species in each group
-    unsigned int npart1, npart2; // numbers of macro-particles in each group
-    unsigned int npairs; // number of pairs of macro-particles
+    unsigned int npart1, npart2; // numbers of macro-particles in each group (then in each cell)
+    unsigned int npairs, npairs_tot; // number of pairs of macro-particles (in the cell, in the patch)
+    vector<unsigned int> first1, first2, sorted1, sorted2; // particles of each group sorted by cell
     vector<unsigned int> np1, np2; // numbers of macro-particles in each species, in each group
     double n1, n2, n12, n123, n223; // densities of particles
     unsigned int i1, i2, ispec1, ispec2, N2max;
@@ -158,7 +288,7 @@ void Collisions::collide(Params& params, Patch* patch, int itime)
            vcv1, vcv2, px_COM, py_COM, pz_COM, p2_COM, p_COM, gamma1_COM, gamma2_COM,
            logL, bmin, s, vrel, smax,
            cosX, sinX, phi, sinXcosPhi, sinXsinPhi, p_perp, inv_p_perp, 
-           newpx_COM, newpy_COM, newpz_COM, U, vcp, n_patch_per_cell;
+           newpx_COM, newpy_COM, newpz_COM, U, vcp;
     bool not_duplicated_particle;
     
     sg1 = &species_group1;
@@ -173,11 +303,16 @@ void Collisions::collide(Params& params, Patch* patch, int itime)
         //temperature = 0.;
     }
     
+    // Skip the timesteps without collisions (see isApplied)
+    if( !applied ) return;
+    double timestep = interval; // time elapsed since the last collisions
+    
     // Initialize some stuff
+    cos_chi& cosChi = cos_chi::instance();
+    coulomb_logarithm& coulombLog = coulomb_logarithm::instance();
     twoPi = 2. * M_PI;
     coeff1 = 4.046650232e-21*params.referenceAngularFrequency_SI; // h*omega/(2*me*c^2)
     coeff2 = 2.817940327e-15*params.referenceAngularFrequency_SI/299792458.; // re omega / c
-    n_patch_per_cell = 1./((double)params.n_cell_per_patch);
     
     // get number of particles for all necessary species
     for (unsigned int i=0; i<2; i++) { // try twice to ensure group 1 has more macro-particles
@@ -205,196 +340,229 @@ void Collisions::collide(Params& params, Patch* patch, int itime)
     // skip to next bin if no particles
     if (npart1==0 || npart2==0) return;
     
-    // Shuffle particles to have random pairs
-    //    (It does not really exchange them, it is just a temporary re-indexing)
-    index1.resize(npart1);
-    for (unsigned int i=0; i<npart1; i++) index1[i] = i; // first, we make an ordered array
-    random_shuffle(index1.begin(), index1.end()); // shuffle the index array
-    if (intra_collisions) { // In the case of collisions within one species
-        npairs = (int) ceil(((double)npart1)/2.); // half as many pairs as macro-particles
-        index2.resize(npairs);
-        for (unsigned int i=0; i<npairs; i++) index2[i] = index1[(i+npairs)%npart1]; // index2 is second half
-        index1.resize(npairs); // index1 is first half
-        N2max = npart1 - npairs; // number of not-repeated particles (in group 2 only)
-    } else { // In the case of collisions between two species
-        npairs = npart1; // as many pairs as macro-particles in group 1 (most numerous)
-        index2.resize(npairs);
-        for (unsigned int i=0; i<npart1; i++) index2[i] = i % npart2;
-        N2max = npart2; // number of not-repeated particles (in group 2 only)
+    // Random numbers of this patch and timestep
+    random.seed( params.random_seed, patch->Hindex() );
+    random.reset( Random::collisions_stream, n_collisions, itime );
+    
+    // Sort the particles of each group by cell, without moving them: the particles of group 1
+    // in cell icell are sorted1[first1[icell]] to sorted1[first1[icell+1]-1] (indices within the group)
+    unsigned int ncells = params.n_cell_per_patch;
+    cell_sort( patch, *sg1, np1, ncells, first1, sorted1 );
+    if (intra_collisions) {
+        first2 = first1;
+    } else {
+        cell_sort( patch, *sg2, np2, ncells, first2, sorted2 );
     }
     
-    // Prepare the ionization
-    Ionization->prepare1(patch->vecSpecies[(*sg1)[0]]->atomic_number);
+    // Species receiving the new electrons of the ionization (the groups may be exchanged in each cell)
+    Species * ionization_s1 = patch->vecSpecies[(*sg1)[0]];
+    Species * ionization_s2 = patch->vecSpecies[(*sg2)[0]];
     
-    // Calculate the densities
-    n1  = 0.; // density of group 1
-    n2  = 0.; // density of group 2
-    n12 = 0.; // "hybrid" density
-    for (unsigned int i=0; i<npairs; i++) { // for each pair of particles
-        // find species and index i1 of particle "1"
-        i1 = index1[i];
-        for (ispec1=0 ; i1>=np1[ispec1]; ispec1++) i1 -= np1[ispec1];
-        // find species and index i2 of particle "2"
-        not_duplicated_particle = (i<N2max);
-        i2 = index2[i];
-        for (ispec2=0 ; i2>=np2[ispec2]; ispec2++) i2 -= np2[ispec2];
-        // Pointers to particles
-        p1 = patch->vecSpecies[(*sg1)[ispec1]]->particles;
-        p2 = patch->vecSpecies[(*sg2)[ispec2]]->particles;
-        // sum weights
-        n1  += p1->weight(i1);
-        if( not_duplicated_particle ) n2  += p2->weight(i2); // special case for group 2 to avoid repeated particles
-        n12 += min( p1->weight(i1), p2->weight(i2) );
-        // Same for ionization
-        Ionization->prepare2(p1, i1, p2, i2, not_duplicated_particle);
-    }
-    if( intra_collisions ) { n1 += n2; n2 = n1; }
-    n1  *= n_patch_per_cell;
-    n2  *= n_patch_per_cell;
-    n12 *= n_patch_per_cell;
+    // The particles collide only with the particles of the same cell
+    npairs_tot = 0;
+    for (unsigned int icell=0; icell<ncells; icell++) {
+        
+        // Numbers of particles of each group in the cell (group 1 must be the most numerous)
+        npart1 = first1[icell+1] - first1[icell];
+        npart2 = first2[icell+1] - first2[icell];
+        if (npart2 > npart1) { // exchange the groups, until another cell exchanges them back
+            sgtmp = sg1; sg1 = sg2; sg2 = sgtmp;
+            np1.swap( np2 );
+            first1.swap( first2 );
+            sorted1.swap( sorted2 );
+            swap( npart1, npart2 );
+        }
+        if (npart2==0 || (intra_collisions && npart1<2)) continue;
+        
+        // Shuffle particles to have random pairs
+        //    (It does not really exchange them, it is just a temporary re-indexing)
+        index1.assign( sorted1.begin()+first1[icell], sorted1.begin()+first1[icell+1] );
+        for (unsigned int i=npart1-1; i>0; i--) // shuffle the index array (Fisher-Yates)
+            swap( index1[i], index1[(unsigned int)( random.uniform()*(i+1) )] );
+        if (intra_collisions) { // In the case of collisions within one species
+            npairs = (int) ceil(((double)npart1)/2.); // half as many pairs as macro-particles
+            index2.resize(npairs);
+            for (unsigned int i=0; i<npairs; i++) index2[i] = index1[(i+npairs)%npart1]; // index2 is second half
+            index1.resize(npairs); // index1 is first half
+            N2max = npart1 - npairs; // number of not-repeated particles (in group 2 only)
+        } else { // In the case of collisions between two species
+            npairs = npart1; // as many pairs as macro-particles in group 1 (most numerous)
+            index2.resize(npairs);
+            for (unsigned int i=0; i<npart1; i++) index2[i] = sorted2[first2[icell] + i % npart2];
+            N2max = npart2; // number of not-repeated particles (in group 2 only)
+        }
+        
+        // Prepare the ionization
+        Ionization->prepare1(patch->vecSpecies[(*sg1)[0]]->atomic_number);
     
-    // Pre-calculate some numbers before the big loop
-    n123 = pow(n1,2./3.);
-    n223 = pow(n2,2./3.);
-    coeff3 = params.timestep * n1*n2/n12;
-    coeff4 = pow( 3.*coeff2 , -1./3. ) * coeff3;
-    coeff3 *= coeff2;
+        // Calculate the densities in the cell
+        n1  = 0.; // density of group 1
+        n2  = 0.; // density of group 2
+        n12 = 0.; // "hybrid" density
+        for (unsigned int i=0; i<npairs; i++) { // for each pair of particles
+            // find species and index i1 of particle "1"
+            i1 = index1[i];
+            for (ispec1=0 ; i1>=np1[ispec1]; ispec1++) i1 -= np1[ispec1];
+            // find species and index i2 of particle "2"
+            not_duplicated_particle = (i<N2max);
+            i2 = index2[i];
+            for (ispec2=0 ; i2>=np2[ispec2]; ispec2++) i2 -= np2[ispec2];
+            // Pointers to particles
+            p1 = patch->vecSpecies[(*sg1)[ispec1]]->particles;
+            p2 = patch->vecSpecies[(*sg2)[ispec2]]->particles;
+            // sum weights
+            n1  += p1->weight(i1);
+            if( not_duplicated_particle ) n2  += p2->weight(i2); // special case for group 2 to avoid repeated particles
+            n12 += min( p1->weight(i1), p2->weight(i2) );
+            // Same for ionization
+            Ionization->prepare2(p1, i1, p2, i2, not_duplicated_particle);
+        }
+        if( intra_collisions ) { n1 += n2; n2 = n1; }
+    
+        // Pre-calculate some numbers before the big loop
+        n123 = pow(n1,2./3.);
+        n223 = pow(n2,2./3.);
+        coeff3 = timestep * n1*n2/n12;
+        coeff4 = pow( 3.*coeff2 , -1./3. ) * coeff3;
+        coeff3 *= coeff2;
     
-    // Prepare the ionization
-    Ionization->prepare3(params.timestep, n_patch_per_cell);
+        // Prepare the ionization
+        Ionization->prepare3(timestep);
     
-    // Now start the real loop on pairs of particles
-    // See equations in http://dx.doi.org/10.1063/1.4742167
-    // ----------------------------------------------------
-    for (unsigned int i=0; i<npairs; i++) {
+        // Now start the real loop on pairs of particles
+        // See equations in http://dx.doi.org/10.1063/1.4742167
+        // ----------------------------------------------------
+        for (unsigned int i=0; i<npairs; i++) {
     
-        // find species and index i1 of particle "1"
-        i1 = index1[i];
-        for (ispec1=0 ; i1>=np1[ispec1]; ispec1++) i1 -= np1[ispec1];
-        // find species and index i2 of particle "2"
-        i2 = index2[i];
-        for (ispec2=0 ; i2>=np2[ispec2]; ispec2++) i2 -= np2[ispec2];
+            // find species and index i1 of particle "1"
+            i1 = index1[i];
+            for (ispec1=0 ; i1>=np1[ispec1]; ispec1++) i1 -= np1[ispec1];
+            // find species and index i2 of particle "2"
+            i2 = index2[i];
+            for (ispec2=0 ; i2>=np2[ispec2]; ispec2++) i2 -= np2[ispec2];
         
-        s1 = patch->vecSpecies[(*sg1)[ispec1]]; s2 = patch->vecSpecies[(*sg2)[ispec2]];
-        p1 = s1->particles;                     p2 = s2->particles;
-        m1 = s1->mass;                          m2 = s2->mass;
-        W1 = p1->weight(i1);                    W2 = p2->weight(i2);
+            s1 = patch->vecSpecies[(*sg1)[ispec1]]; s2 = patch->vecSpecies[(*sg2)[ispec2]];
+            p1 = s1->particles;                     p2 = s2->particles;
+            m1 = s1->mass;                          m2 = s2->mass;
+            W1 = p1->weight(i1);                    W2 = p2->weight(i2);
         
-        // Calculate stuff
-        m12  = m1 / m2; // mass ratio
-        qqm  = p1->charge(i1) * p2->charge(i2) / m1;
-        qqm2 = qqm * qqm;
+            // Calculate stuff
+            m12  = m1 / m2; // mass ratio
+            qqm  = p1->charge(i1) * p2->charge(i2) / m1;
+            qqm2 = qqm * qqm;
         
-        // Get momenta and calculate gammas
-        gamma1 = sqrt(1. + pow(p1->momentum(0,i1),2) + pow(p1->momentum(1,i1),2) + pow(p1->momentum(2,i1),2));
-        gamma2 = sqrt(1. + pow(p2->momentum(0,i2),2) + pow(p2->momentum(1,i2),2) + pow(p2->momentum(2,i2),2));
-        gamma12 = m12 * gamma1 + gamma2;
-        gamma12_inv = 1./gamma12;
+            // Get momenta and calculate gammas
+            gamma1 = sqrt(1. + pow(p1->momentum(0,i1),2) + pow(p1->momentum(1,i1),2) + pow(p1->momentum(2,i1),2));
+            gamma2 = sqrt(1. + pow(p2->momentum(0,i2),2) + pow(p2->momentum(1,i2),2) + pow(p2->momentum(2,i2),2));
+            gamma12 = m12 * gamma1 + gamma2;
+            gamma12_inv = 1./gamma12;
         
-        // Calculate the center-of-mass (COM) frame
-        // Quantities starting with "COM" are those of the COM itself, expressed in the lab frame.
-        // They are NOT quantities relative to the COM.
-        COM_vx = ( m12 * (p1->momentum(0,i1)) + p2->momentum(0,i2) ) * gamma12_inv;
-        COM_vy = ( m12 * (p1->momentum(1,i1)) + p2->momentum(1,i2) ) * gamma12_inv;
-        COM_vz = ( m12 * (p1->momentum(2,i1)) + p2->momentum(2,i2) ) * gamma12_inv;
-        COM_vsquare = COM_vx*COM_vx + COM_vy*COM_vy + COM_vz*COM_vz;
-        COM_gamma = pow( 1.-COM_vsquare , -0.5);
+            // Calculate the center-of-mass (COM) frame
+            // Quantities starting with "COM" are those of the COM itself, expressed in the lab frame.
+            // They are NOT quantities relative to the COM.
+            COM_vx = ( m12 * (p1->momentum(0,i1)) + p2->momentum(0,i2) ) * gamma12_inv;
+            COM_vy = ( m12 * (p1->momentum(1,i1)) + p2->momentum(1,i2) ) * gamma12_inv;
+            COM_vz = ( m12 * (p1->momentum(2,i1)) + p2->momentum(2,i2) ) * gamma12_inv;
+            COM_vsquare = COM_vx*COM_vx + COM_vy*COM_vy + COM_vz*COM_vz;
+            COM_gamma = pow( 1.-COM_vsquare , -0.5);
         
-        // Change the momentum to the COM frame (we work only on particle 1)
-        // Quantities ending with "COM" are quantities of the particle expressed in the COM frame.
-        term1 = (COM_gamma - 1.) / COM_vsquare;
-        vcv1  = (COM_vx*(p1->momentum(0,i1)) + COM_vy*(p1->momentum(1,i1)) + COM_vz*(p1->momentum(2,i1)))/gamma1;
-        vcv2  = (COM_vx*(p2->momentum(0,i2)) + COM_vy*(p2->momentum(1,i2)) + COM_vz*(p2->momentum(2,i2)))/gamma2;
-        term2 = (term1*vcv1 - COM_gamma) * gamma1;
-        px_COM = (p1->momentum(0,i1)) + term2*COM_vx;
-        py_COM = (p1->momentum(1,i1)) + term2*COM_vy;
-        pz_COM = (p1->momentum(2,i1)) + term2*COM_vz;
-        p2_COM = px_COM*px_COM + py_COM*py_COM + pz_COM*pz_COM;
-        p_COM  = sqrt(p2_COM);
-        gamma1_COM = (1.-vcv1)*COM_gamma*gamma1;
-        gamma2_COM = (1.-vcv2)*COM_gamma*gamma2;
+            // Change the momentum to the COM frame (we work only on particle 1)
+            // Quantities ending with "COM" are quantities of the particle expressed in the COM frame.
+            term1 = (COM_gamma - 1.) / COM_vsquare;
+            vcv1  = (COM_vx*(p1->momentum(0,i1)) + COM_vy*(p1->momentum(1,i1)) + COM_vz*(p1->momentum(2,i1)))/gamma1;
+            vcv2  = (COM_vx*(p2->momentum(0,i2)) + COM_vy*(p2->momentum(1,i2)) + COM_vz*(p2->momentum(2,i2)))/gamma2;
+            term2 = (term1*vcv1 - COM_gamma) * gamma1;
+            px_COM = (p1->momentum(0,i1)) + term2*COM_vx;
+            py_COM = (p1->momentum(1,i1)) + term2*COM_vy;
+            pz_COM = (p1->momentum(2,i1)) + term2*COM_vz;
+            p2_COM = px_COM*px_COM + py_COM*py_COM + pz_COM*pz_COM;
+            p_COM  = sqrt(p2_COM);
+            gamma1_COM = (1.-vcv1)*COM_gamma*gamma1;
+            gamma2_COM = (1.-vcv2)*COM_gamma*gamma2;
         
-        // Calculate some intermediate quantities
-        term3 = COM_gamma * gamma12_inv;
-        term4 = gamma1_COM * gamma2_COM;
-        term5 = term4/p2_COM + m12;
+            // Calculate some intermediate quantities
+            term3 = COM_gamma * gamma12_inv;
+            term4 = gamma1_COM * gamma2_COM;
+            term5 = term4/p2_COM + m12;
         
-        // Calculate coulomb log if necessary
-        logL = coulomb_log;
-        if( logL <= 0. ) { // if auto-calculation requested
-            bmin = max( coeff1/m1/p_COM , abs(coeff2*qqm*term3*term5) ); // min impact parameter
-            logL = 0.5*log(1.+patch->debye_length_squared/pow(bmin,2));
-            if (logL < 2.) logL = 2.;
-        }
+            // Calculate coulomb log if necessary
+            logL = coulomb_log;
+            if( logL <= 0. ) { // if auto-calculation requested
+                bmin = max( coeff1/m1/p_COM , abs(coeff2*qqm*term3*term5) ); // min impact parameter
+                logL = coulombLog.call( patch->debye_length_squared/(bmin*bmin) ); // at least 2
+            }
         
-        // Calculate the collision parameter s12 (similar to number of real collisions)
-        s = coeff3 * logL * qqm2 * term3 * p_COM * term5*term5 / (gamma1*gamma2);
+            // Calculate the collision parameter s12 (similar to number of real collisions)
+            s = coeff3 * logL * qqm2 * term3 * p_COM * term5*term5 / (gamma1*gamma2);
         
-        // Low-temperature correction
-        vrel = p_COM/term3/term4; // relative velocity
-        smax = coeff4 * (m12+1.) * vrel / max(m12*n123,n223);
-        if (s>smax) s = smax;
+            // Low-temperature correction
+            vrel = p_COM/term3/term4; // relative velocity
+            smax = coeff4 * (m12+1.) * vrel / max(m12*n123,n223);
+            if (s>smax) s = smax;
         
-        // Pick the deflection angles according to Nanbu's theory
-        cosX = cos_chi(s);
-        sinX = sqrt( 1. - cosX*cosX );
-        //!\todo make a faster rand by preallocating ??
-        phi = twoPi * ((double)rand() / RAND_MAX);
+            // Pick the deflection angles according to Nanbu's theory
+            cosX = cosChi.call(s, random.uniform());
+            sinX = sqrt( 1. - cosX*cosX );
+            phi = twoPi * random.uniform();
         
-        // Calculate combination of angles
-        sinXcosPhi = sinX*cos(phi);
-        sinXsinPhi = sinX*sin(phi);
+            // Calculate combination of angles
+            sinXcosPhi = sinX*cos(phi);
+            sinXsinPhi = sinX*sin(phi);
         
-        // Apply the deflection
-        p_perp = sqrt( px_COM*px_COM + py_COM*py_COM );
-        if( p_perp > 1.e-10*p_COM ) { // make sure p_perp is not too small
-            inv_p_perp = 1./p_perp;
-            newpx_COM = (px_COM * pz_COM * sinXcosPhi - py_COM * p_COM * sinXsinPhi) * inv_p_perp + px_COM * cosX;
-            newpy_COM = (py_COM * pz_COM * sinXcosPhi + px_COM * p_COM * sinXsinPhi) * inv_p_perp + py_COM * cosX;
-            newpz_COM = -p_perp * sinXcosPhi  +  pz_COM * cosX;
-        } else { // if p_perp is too small, we use the limit px->0, py=0
-            newpx_COM = p_COM * sinXcosPhi;
-            newpy_COM = p_COM * sinXsinPhi;
-            newpz_COM = p_COM * cosX;
-        }
+            // Apply the deflection
+            p_perp = sqrt( px_COM*px_COM + py_COM*py_COM );
+            if( p_perp > 1.e-10*p_COM ) { // make sure p_perp is not too small
+                inv_p_perp = 1./p_perp;
+                newpx_COM = (px_COM * pz_COM * sinXcosPhi - py_COM * p_COM * sinXsinPhi) * inv_p_perp + px_COM * cosX;
+                newpy_COM = (py_COM * pz_COM * sinXcosPhi + px_COM * p_COM * sinXsinPhi) * inv_p_perp + py_COM * cosX;
+                newpz_COM = -p_perp * sinXcosPhi  +  pz_COM * cosX;
+            } else { // if p_perp is too small, we use the limit px->0, py=0
+                newpx_COM = p_COM * sinXcosPhi;
+                newpy_COM = p_COM * sinXsinPhi;
+                newpz_COM = p_COM * cosX;
+            }
         
-        // Random number to choose whether deflection actually applies.
-        // This is to conserve energy in average when weights are not equal.
-        //!\todo make a faster rand by preallocating ??
-        U = ((double)rand() / RAND_MAX);
+            // Random number to choose whether deflection actually applies.
+            // This is to conserve energy in average when weights are not equal.
+            U = random.uniform();
         
-        // Go back to the lab frame and store the results in the particle array
-        vcp = COM_vx * newpx_COM + COM_vy * newpy_COM + COM_vz * newpz_COM;
-        if( U < W2/W1 ) { // deflect particle 1 only with some probability
-            term6 = term1*vcp + gamma1_COM * COM_gamma;
-            p1->momentum(0,i1) = newpx_COM + COM_vx * term6;
-            p1->momentum(1,i1) = newpy_COM + COM_vy * term6;
-            p1->momentum(2,i1) = newpz_COM + COM_vz * term6;
-        }
-        if( U < W1/W2 ) { // deflect particle 2 only with some probability
-            term6 = -m12 * term1*vcp + gamma2_COM * COM_gamma;
-            p2->momentum(0,i2) = -m12 * newpx_COM + COM_vx * term6;
-            p2->momentum(1,i2) = -m12 * newpy_COM + COM_vy * term6;
-            p2->momentum(2,i2) = -m12 * newpz_COM + COM_vz * term6;
-        }
+            // Go back to the lab frame and store the results in the particle array
+            vcp = COM_vx * newpx_COM + COM_vy * newpy_COM + COM_vz * newpz_COM;
+            if( U < W2/W1 ) { // deflect particle 1 only with some probability
+                term6 = term1*vcp + gamma1_COM * COM_gamma;
+                p1->momentum(0,i1) = newpx_COM + COM_vx * term6;
+                p1->momentum(1,i1) = newpy_COM + COM_vy * term6;
+                p1->momentum(2,i1) = newpz_COM + COM_vz * term6;
+            }
+            if( U < W1/W2 ) { // deflect particle 2 only with some probability
+                term6 = -m12 * term1*vcp + gamma2_COM * COM_gamma;
+                p2->momentum(0,i2) = -m12 * newpx_COM + COM_vx * term6;
+                p2->momentum(1,i2) = -m12 * newpy_COM + COM_vy * term6;
+                p2->momentum(2,i2) = -m12 * newpz_COM + COM_vz * term6;
+            }
         
-        // Handle ionization
-        Ionization->apply(p1, i1, p2, i2);
+            // Handle ionization
+            Ionization->apply(p1, i1, p2, i2, random);
         
-        if( debug ) {
-            smean    += s;
-            logLmean += logL;
-            //temperature += m1 * (sqrt(1.+pow(p1->momentum(0,i1),2)+pow(p1->momentum(1,i1),2)+pow(p1->momentum(2,i1),2))-1.);
-        }
+            if( debug ) {
+                smean    += s;
+                logLmean += logL;
+                //temperature += m1 * (sqrt(1.+pow(p1->momentum(0,i1),2)+pow(p1->momentum(1,i1),2)+pow(p1->momentum(2,i1),2))-1.);
+            }
         
-    } // end loop on pairs of particles
+        } // end loop on pairs of particles
+    
+        npairs_tot += npairs;
+        
+    } // end loop on cells
     
     // temporary to be removed
-    Ionization->finish(patch->vecSpecies[(*sg1)[0]], patch->vecSpecies[(*sg2)[0]], params, patch);
+    Ionization->prepare1(ionization_s1->atomic_number);
+    Ionization->finish(ionization_s1, ionization_s2, params, patch);
     
     if(debug) {
-        if( npairs>0 ) {
-            ncol = (double)npairs;
+        if( npairs_tot>0 ) {
+            ncol = (double)npairs_tot;
             smean    /= ncol;
             logLmean /= ncol;
             //temperature /= ncol;
@@ -403,6 +571,35 @@ void Collisions::collide(Params& params, Patch* patch, int itime)
 }
 
 
+// Sort the particles of a group of species by cell (counting sort of their indices within the group,
+// np being the numbers of particles of each species): the particles of cell icell are sorted[first[icell]]
+// to sorted[first[icell+1]-1]
+void Collisions::cell_sort(Patch* patch, vector<unsigned int> &group, vector<unsigned int> &np, unsigned int ncells,
+                           vector<unsigned int> &first, vector<unsigned int> &sorted)
+{
+    unsigned int npart = 0;
+    for (unsigned int ispec=0; ispec<group.size(); ispec++) npart += np[ispec];
+    
+    // Count the particles of each cell
+    vector<unsigned int> cell(npart);
+    first.assign(ncells+1, 0);
+    unsigned int i = 0;
+    for (unsigned int ispec=0; ispec<group.size(); ispec++) {
+        Species* s = patch->vecSpecies[group[ispec]];
+        for (unsigned int ipart=0; ipart<np[ispec]; ipart++, i++) {
+            cell[i] = s->cell_index(ipart);
+            first[cell[i]+1]++;
+        }
+    }
+    for (unsigned int icell=0; icell<ncells; icell++) first[icell+1] += first[icell];
+    
+    // Place each particle after the previous ones of its cell (in the order of the species)
+    vector<unsigned int> next(first.begin(), first.end()-1);
+    sorted.resize(npart);
+    for (i=0; i<npart; i++) sorted[next[cell[i]]++] = i;
+}
+
+
 void Collisions::debug(Params& params, int itime, unsigned int icoll, VectorPatch& vecPatches)
 {
     
@@ -475,36 +672,6 @@ void Collisions::debug(Params& params, int itime, unsigned int icoll, VectorPatc
 }
 
 
-// Technique given by Nanbu in http://dx.doi.org/10.1103/PhysRevE.55.4642
-//   to pick randomly the deflection angle cosine, in the center-of-mass frame.
-// It involves the "s" parameter (~ collision frequency * deflection expectation)
-//   and a random number "U".
-// Technique slightly modified in http://dx.doi.org/10.1063/1.4742167
-inline double Collisions::cos_chi(double s)
-{
-    
-    double A, invA;
-    //!\todo make a faster rand by preallocating ??
-    double U = (double)rand() / RAND_MAX;
-    
-    if( s < 0.1 ) {
-        if ( U<0.0001 ) U=0.0001; // ensures cos_chi > 0
-        return 1. + s*log(U);
-    }
-    if( s < 3.  ) {
-        // the polynomial has been modified from the article in order to have a better form
-        invA = 0.00569578 +(0.95602 + (-0.508139 + (0.479139 + ( -0.12789 + 0.0238957*s )*s )*s )*s )*s;
-        A = 1./invA;
-        return  invA  * log( exp(-A) + 2.*U*sinh(A) );
-    }
-    if( s < 6.  ) {
-        A = 3.*exp(-s);
-        return (1./A) * log( exp(-A) + 2.*U*sinh(A) );
-    }
-    return 2.*U - 1.;
-    
-}
-
 
 
 
@@ -8,6 +8,7 @@
 #include "Species.h"
 #include "CollisionalIonization.h"
 #include "H5.h"
+#include "Random.h"
 
 class Patch;
 
@@ -16,7 +17,7 @@ class Collisions
 
 public:
     //! Constructor for Collisions between two species
-    Collisions( Patch* patch, unsigned int n_collisions, std::vector<unsigned int>,std::vector<unsigned int>, double coulomb_log, bool intra_collisions,int debug_every,int Z,bool ionizing,int nDim,double,std::string);
+    Collisions( Patch* patch, unsigned int n_collisions, std::vector<unsigned int>,std::vector<unsigned int>, double coulomb_log, bool intra_collisions,int every,double adaptive_s,int debug_every,int Z,bool ionizing,int nDim,double,std::string);
     //! Cloning Constructor
     Collisions(Collisions*, int);
     //! destructor
@@ -27,26 +28,40 @@ public:
     //! Method that clones a vector of Collisions objects
     static std::vector<Collisions*> clone(std::vector<Collisions*>, Params&);
     
-    //! Method to calculate the Debye length in each cluster
+    //! Method to calculate the Debye length in each cluster (and the collision frequencies of the adaptive collisions)
     static void calculate_debye_length(Params&, Patch*);
     
-    //! is true if any of the collisions objects need automatically-computed coulomb log
+    //! is true if any of the collisions objects need automatically-computed coulomb log or adaptive interval
     static bool debye_length_required;
     
+    //! Method called in the main smilei loop, before collide, to know if the collisions are applied at this timestep
+    bool isApplied(Params&, int);
+    
     //! Method called in the main smilei loop to apply collisions at each timestep
     void collide(Params&, Patch* ,int);
     
+    //! Dump and restart the state of the adaptive interval (checkpoints)
+    void dumpInterval(hid_t patch_gid);
+    void restartInterval(hid_t patch_gid);
+    //! Send and receive the state of the adaptive interval with the patch (patch exchange between processes, one tag)
+    void isendInterval(int to, int tag);
+    void recvInterval(int from, int tag);
+    
     //! Outputs the debug info if requested
     static void debug(Params& params, int itime, unsigned int icoll, VectorPatch& vecPatches);
     
-    //! Deflection angle calculation
-    static double cos_chi(double);
-    
 private:
     
     //! Identification number of the Collisions object
     int n_collisions;
     
+    //! Sort the particles of a group of species by cell, without moving them
+    void cell_sort(Patch* patch, std::vector<unsigned int> &group, std::vector<unsigned int> &np, unsigned int ncells,
+                   std::vector<unsigned int> &first, std::vector<unsigned int> &sorted);
+    
+    //! Random numbers of the collisions in the patch (stream of the timestep)
+    Random random;
+    
     //! Group of the species numbers that are associated for Collisions.
     std::vector<unsigned int> species_group1, species_group2;
     
@@ -59,6 +74,31 @@ private:
     //! Number of timesteps between each dump of collisions debugging
     int debug_every;
     
+    //! Number of timesteps between two collisions (maximum number if adaptive)
+    int every;
+    
+    //! If positive, the collisions of the patch are applied as soon as the collision parameter accumulated
+    //! since the last ones (frequency * elapsed time) exceeds this value
+    double adaptive_s;
+    
+    //! Number of timesteps since the last collisions of the patch (adaptive interval only)
+    int elapsed;
+    
+    //! Collision frequency in the patch estimated at the last collisions (adaptive interval only)
+    double frequency;
+    
+    //! Copy of (elapsed, frequency) sent with the patch, and its request, completed before the collisions are deleted
+    double interval_send[2];
+    MPI_Request interval_request;
+    
+    //! Whether the collisions are applied at the current timestep, and the time elapsed since the last ones
+    bool applied;
+    double interval;
+    
+    //! Estimate the collision frequency from the densities, mean charges and temperatures of the species of the patch
+    void calculate_frequency(Params&, Patch*, std::vector<double> &density, std::vector<double> &charge,
+                             std::vector<double> &temperature);
+    
     //! CollisionalIonization object, created if ionization required
     CollisionalIonization * Ionization;
     
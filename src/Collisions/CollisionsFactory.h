@@ -5,6 +5,7 @@
 #include "Collisions.h"
 #include "Params.h"
 #include "PyTools.h"
+#include "tabulatedFunctions.h"
 
 class CollisionsFactory {
 public:
@@ -16,7 +17,8 @@ public:
         std::vector<std::vector<unsigned int>> sgroup;
         double clog;
         bool intra, ionizing;
-        int debug_every, Z, Z0, Z1;
+        int debug_every, every, Z, Z0, Z1;
+        double adaptive_s;
         std::string filename;
         std::ostringstream mystream;
         Species *s0, *s;
@@ -58,6 +60,19 @@ public:
         PyTools::extract("coulomb_log",clog,"Collisions",n_collisions);
         if (clog <= 0.) debye_length_required = true; // auto coulomb log requires debye length
         
+        // Number of timesteps between two collisions (maximum number if adaptive)
+        every = 1; // default
+        PyTools::extract("every",every,"Collisions",n_collisions);
+        if (every < 1)
+            ERROR("In collisions #" << n_collisions << ": `every` must be at least 1");
+        
+        // Collision parameter triggering the collisions of a patch (if zero or unset, fixed interval)
+        adaptive_s = 0.; // default
+        PyTools::extract("adaptive_s",adaptive_s,"Collisions",n_collisions);
+        if (adaptive_s < 0.)
+            ERROR("In collisions #" << n_collisions << ": `adaptive_s` must be positive");
+        if (adaptive_s > 0.) debye_length_required = true; // the collision frequency is computed with the debye length
+        
         // Number of timesteps between each debug output (if 0 or unset, no debug)
         debug_every = 0; // default
         PyTools::extract("debug_every",debug_every,"Collisions",n_collisions);
@@ -110,6 +125,11 @@ public:
             MESSAGE(2,"Collisions between species " << mystream.str() << ")");
         }
         MESSAGE(2,"Coulomb logarithm: " << clog);
+        if( adaptive_s>0. ) {
+            MESSAGE(2,"Adaptive interval (collision parameter " << adaptive_s << "), at most " << every << " timesteps");
+        } else if( every>1 ) {
+            MESSAGE(2,"Every " << every << " timesteps");
+        }
         if( debug_every>0 ) MESSAGE(2,"Debug every " << debug_every << " timesteps");
         mystream.str(""); // clear
         if( ionizing>0 ) MESSAGE(2,"Collisional ionization with atomic number "<<Z);
@@ -152,6 +172,8 @@ public:
                 sgroup[0],
                 sgroup[1],
                 clog, intra,
+                every,
+                adaptive_s,
                 debug_every,
                 Z,
                 ionizing,
@@ -179,6 +201,12 @@ public:
             vecCollisions.push_back( create(params, patch, vecSpecies, n_collisions, debye_length_required) );
         }
         
+        // load the tabulated deflection angle and Coulomb logarithm
+        if (numcollisions > 0) {
+            cos_chi::instance().prepare();
+            coulomb_logarithm::instance().prepare();
+        }
+        
         // pass the variable "debye_length_required" into the Collision class
         Collisions::debye_length_required = debye_length_required;
         
@@ -347,9 +347,9 @@ void DiagnosticProbes::init(Params& params, SmileiMPI* smpi, VectorPatch& vecPat
     H5Pclose(plist_id);
     // Write
     if ( nPart_MPI>0 )
-        H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, transfer, &(posArray->data_2D[0][0]) );
+        H5Dwrite( dset_id, H5T_NATIVE_FIELD_REAL, memspace, filespace, transfer, &(posArray->data_2D[0][0]) );
     else
-        H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, transfer, NULL );
+        H5Dwrite( dset_id, H5T_NATIVE_FIELD_REAL, memspace, filespace, transfer, NULL );
     H5Dclose(dset_id);
     H5Pclose( transfer );
     H5Sclose(filespace);
@@ -593,7 +593,7 @@ void DiagnosticProbes::run( SmileiMPI* smpi, VectorPatch& vecPatches, int timest
         hid_t transfer = H5Pcreate(H5P_DATASET_XFER);
         H5Pset_dxpl_mpio(transfer, H5FD_MPIO_INDEPENDENT);
         // Write
-        H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, memspace, filespace, transfer, &(probesArray->data_2D[0][0]) );
+        H5Dwrite( dset_id, H5T_NATIVE_FIELD_REAL, memspace, filespace, transfer, &(probesArray->data_2D[0][0]) );
         H5Dclose(dset_id);
         H5Pclose( transfer );
         H5Sclose(filespace);
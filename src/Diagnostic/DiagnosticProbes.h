@@ -51,12 +51,12 @@ public :
         int size(0);
         if (posArray!=NULL) {
             // Size of the array of position
-            size += posArray->globalDims_*sizeof(double);
+            size += posArray->globalDims_*sizeof(field_real);
             // Size of the simili particles structure
             int partSize = (2*posArray->dims_[1]+3+1)*sizeof(double)+sizeof(short)+sizeof(unsigned int);
             size += posArray->dims_[0]*partSize;
             // eval probesArray (even if temporary)
-            size += posArray->dims_[0]*10*sizeof(double);
+            size += posArray->dims_[0]*10*sizeof(field_real);
         }
         return size;
     }
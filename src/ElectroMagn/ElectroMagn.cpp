@@ -58,6 +58,7 @@ nrj_new_fields (  0.               )
     Jy_=NULL;
     Jz_=NULL;
     rho_=NULL;
+    rhoJ_zero=false;
     
     // Species charge currents and density
     Jx_s.resize(n_species);
@@ -75,6 +76,7 @@ nrj_new_fields (  0.               )
         for (unsigned int j=0; j<2; j++) {
             istart[i][j]=0;
             bufsize[i][j]=0;
+            bc_width[i][j]=0;
         }
     }
     
@@ -82,6 +84,7 @@ nrj_new_fields (  0.               )
     emBoundCond = ElectroMagnBC_Factory::create(params, patch);
     
     MaxwellFaradaySolver_ = SolverFactory::create(params);
+    fusedMaxwell = false;
     
 }
 
@@ -118,6 +121,7 @@ nrj_new_fields ( 0. )
     Jy_=NULL;
     Jz_=NULL;
     rho_=NULL;
+    rhoJ_zero=false;
     
     // Species charge currents and density
     Jx_s.resize(n_species);
@@ -135,6 +139,7 @@ nrj_new_fields ( 0. )
         for (unsigned int j=0; j<2; j++) {
             istart[i][j]=0;
             bufsize[i][j]=0;
+            bc_width[i][j]=0;
         }
     }
     
@@ -142,6 +147,7 @@ nrj_new_fields ( 0. )
     emBoundCond = ElectroMagnBC_Factory::create(params, patch);
     
     MaxwellFaradaySolver_ = SolverFactory::create(params);
+    fusedMaxwell = false;
 }
 
 
@@ -261,6 +267,21 @@ void ElectroMagn::boundaryConditions(int itime, double time_dual, Patch* patch,
 
 }
 
+bool ElectroMagn::setBoundaryConditionsWidth(double time_dual, Patch* patch, SimWindow* simWindow)
+{
+    // Same tests as boundaryConditions, the conditions being applied only on the borders of the simulation box
+    // and at most on the ghost planes
+    bool moving = simWindow && simWindow->isMoving(time_dual);
+    bool bc = false;
+    for (unsigned int i=0 ; i<3 ; i++) {
+        bool apply = ( emBoundCond.size()>2*i ) && ( emBoundCond[2*i]!=NULL ) && ( i>0 || !moving );
+        bc_width[i][0] = ( apply && patch->locateOnBorders(i, 0) ) ? oversize[i] : 0;
+        bc_width[i][1] = ( apply && patch->locateOnBorders(i, 1) ) ? oversize[i] : 0;
+        bc = bc || bc_width[i][0]>0 || bc_width[i][1]>0;
+    }
+    return bc;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Method used to create a dump of the data contained in ElectroMagn
 // ---------------------------------------------------------------------------------------------------------------------
@@ -297,14 +318,21 @@ void ElectroMagn::dump()
 // ---------------------------------------------------------------------------------------------------------------------
 void ElectroMagn::restartRhoJ()
 {
+    // The arrays of the patches without particles around stay zero from one step to the next
+    if ( rhoJ_zero ) return;
+    
     Jx_ ->put_to(0.);
     Jy_ ->put_to(0.);
     Jz_ ->put_to(0.);
     rho_->put_to(0.);
+    rhoJ_zero = true;
 }
 
 void ElectroMagn::restartRhoJs()
 {
+    // The densities of the species are also zero in the patches without particles around
+    if ( rhoJ_zero ) return;
+    
     for (unsigned int ispec=0 ; ispec < n_species ; ispec++) {
         if( Jx_s [ispec] ) Jx_s [ispec]->put_to(0.);
         if( Jy_s [ispec] ) Jy_s [ispec]->put_to(0.);
@@ -316,6 +344,7 @@ void ElectroMagn::restartRhoJs()
     Jy_ ->put_to(0.);
     Jz_ ->put_to(0.);
     rho_->put_to(0.);
+    rhoJ_zero = true;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -390,6 +419,7 @@ void ElectroMagn::applyAntenna(unsigned int iAntenna, double intensity) {
         
         for (unsigned int i=0; i< field->globalDims_ ; i++)
             (*field)(i) += intensity * (*antennaField)(i);
+        rhoJ_zero = false;
         
     }
 }
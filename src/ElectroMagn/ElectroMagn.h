@@ -162,6 +162,9 @@ public:
     
     //! Method used to initialize the total charge currents and densities
     void restartRhoJ();
+    //! True if Jx_, Jy_, Jz_ and rho_ are zero everywhere (no particles nor antenna in the patch and its neighbours):
+    //! then restartRhoJ has nothing to reset, the sums with the neighbours are skipped and Maxwell-Ampere ignores J
+    bool rhoJ_zero;
     //! Method used to initialize the total charge currents and densities of species
     void restartRhoJs();
     
@@ -202,7 +205,20 @@ public:
     virtual void centerMagneticFields() = 0;
     virtual void binomialCurrentFilter() = 0;
     
+    //! True if solveMaxwellFused is available (Yee solver in 2D and 3D)
+    bool fusedMaxwell;
+    //! Maxwell-Ampere and Maxwell-Faraday (Yee) in a single pass over the arrays: B_m is set to B at time n+1/2,
+    //! or to B at time n on the borders listed in bc_width (then centered by centerMagneticFieldsOnBorders)
+    virtual void solveMaxwellFused() {};
+    //! Method used to center the Magnetic fields on the borders listed in bc_width only
+    virtual void centerMagneticFieldsOnBorders() {};
+    
     void boundaryConditions(int itime, double time_dual, Patch* patch, Params &params, SimWindow* simWindow);
+    //! Set bc_width for the current step, and return true if boundaryConditions modifies the fields of the patch
+    bool setBoundaryConditionsWidth(double time_dual, Patch* patch, SimWindow* simWindow);
+    //! Number of planes modified by boundaryConditions on the min and max borders of each dimension
+    //! (the ghost planes on the borders of the simulation box with boundary conditions, 0 elsewhere)
+    unsigned int bc_width[3][2];
     
     void laserDisabled();
     
@@ -272,7 +288,7 @@ public:
         for (size_t i=0 ; i<nDim_field ; i++)
             emSize *= dimPrim[i];
     
-        emSize *= sizeof(double);
+        emSize *= sizeof(field_real);
         return emSize;
     }
     
@@ -42,6 +42,9 @@ isYmax(patch->isYmax())
     dt_ov_dy = timestep/dy;
     dy_ov_dt = 1.0/dt_ov_dy;
     
+    // The Yee solver is fused with Maxwell-Ampere (see solveMaxwellFused)
+    fusedMaxwell = ( params.maxwell_sol == "Yee" );
+    
     // ----------------------
     // Electromagnetic fields
     // ----------------------
@@ -168,6 +171,9 @@ isYmax(patch->isYmax())
     dt_ov_dy = timestep/dy;
     dy_ov_dt = 1.0/dt_ov_dy;
     
+    // The Yee solver is fused with Maxwell-Ampere (see solveMaxwellFused)
+    fusedMaxwell = ( params.maxwell_sol == "Yee" );
+    
     // ----------------------
     // Electromagnetic fields
     // ----------------------
@@ -547,28 +553,28 @@ void ElectroMagn2D::saveMagneticFields()
     
     // Magnetic field Bx^(p,d)
     for (unsigned int i=0 ; i<nx_p ; i++) {
-        memcpy(&((*Bx2D_m)(i,0)), &((*Bx2D)(i,0)),ny_d*sizeof(double) );
+        memcpy(&((*Bx2D_m)(i,0)), &((*Bx2D)(i,0)),ny_d*sizeof(field_real) );
         //for (unsigned int j=0 ; j<ny_d ; j++) {
         //    (*Bx2D_m)(i,j)=(*Bx2D)(i,j);
         //}
     
     // Magnetic field By^(d,p)
-        memcpy(&((*By2D_m)(i,0)), &((*By2D)(i,0)),ny_p*sizeof(double) );
+        memcpy(&((*By2D_m)(i,0)), &((*By2D)(i,0)),ny_p*sizeof(field_real) );
         //for (unsigned int j=0 ; j<ny_p ; j++) {
         //    (*By2D_m)(i,j)=(*By2D)(i,j);
         //}
     
     // Magnetic field Bz^(d,d)
-        memcpy(&((*Bz2D_m)(i,0)), &((*Bz2D)(i,0)),ny_d*sizeof(double) );
+        memcpy(&((*Bz2D_m)(i,0)), &((*Bz2D)(i,0)),ny_d*sizeof(field_real) );
         //for (unsigned int j=0 ; j<ny_d ; j++) {
         //    (*Bz2D_m)(i,j)=(*Bz2D)(i,j);
         //}
     }// end for i
-        memcpy(&((*By2D_m)(nx_p,0)), &((*By2D)(nx_p,0)),ny_p*sizeof(double) );
+        memcpy(&((*By2D_m)(nx_p,0)), &((*By2D)(nx_p,0)),ny_p*sizeof(field_real) );
         //for (unsigned int j=0 ; j<ny_p ; j++) {
         //    (*By2D_m)(nx_p,j)=(*By2D)(nx_p,j);
         //}
-        memcpy(&((*Bz2D_m)(nx_p,0)), &((*Bz2D)(nx_p,0)),ny_d*sizeof(double) );
+        memcpy(&((*Bz2D_m)(nx_p,0)), &((*Bz2D)(nx_p,0)),ny_d*sizeof(field_real) );
         //for (unsigned int j=0 ; j<ny_d ; j++) {
         //    (*Bz2D_m)(nx_p,j)=(*Bz2D)(nx_p,j);
         //}
@@ -715,6 +721,155 @@ void ElectroMagn2D::centerMagneticFields()
 }//END centerMagneticFields
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Solve Maxwell-Ampere and Maxwell-Faraday (Yee) in a single pass, B_m being set to B at time n+1/2
+// (or n on the planes modified by the boundary conditions)
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn2D::solveMaxwellFused()
+{
+    // Static-cast of the fields
+    Field2D* Ex2D = static_cast<Field2D*>(Ex_);
+    Field2D* Ey2D = static_cast<Field2D*>(Ey_);
+    Field2D* Ez2D = static_cast<Field2D*>(Ez_);
+    Field2D* Bx2D = static_cast<Field2D*>(Bx_);
+    Field2D* By2D = static_cast<Field2D*>(By_);
+    Field2D* Bz2D = static_cast<Field2D*>(Bz_);
+    Field2D* Bx2D_m = static_cast<Field2D*>(Bx_m);
+    Field2D* By2D_m = static_cast<Field2D*>(By_m);
+    Field2D* Bz2D_m = static_cast<Field2D*>(Bz_m);
+    Field2D* Jx2D = static_cast<Field2D*>(Jx_);
+    Field2D* Jy2D = static_cast<Field2D*>(Jy_);
+    Field2D* Jz2D = static_cast<Field2D*>(Jz_);
+    // Without currents, J is read from a row of zeros, which stays in cache (-timestep*0. being -0., E is unchanged)
+    if ( rhoJ_zero && zero_row.size()<ny_d )
+        zero_row.resize( ny_d, 0. );
+    
+    // The rows i are swept in increasing order. E in row i needs B in rows i and i+1, not advanced yet,
+    // and B in row i needs E in rows i and i-1, already advanced:
+    // the results are those of solveMaxwellAmpere followed by MF_Solver2D_Yee
+    for (unsigned int i=0 ; i<nx_d ; i++) {
+        
+        // Electric field Ex^(d,p)
+        {
+            field_real* Ex = &(*Ex2D)(i,0);
+            field_real* Jx = rhoJ_zero ? zero_row.data() : &(*Jx2D)(i,0);
+            field_real* Bz = &(*Bz2D)(i,0);
+            #pragma omp simd
+            for (unsigned int j=0 ; j<ny_p ; j++) {
+                Ex[j] += -timestep*Jx[j] + dt_ov_dy * ( Bz[j+1] - Bz[j] );
+            }
+        }
+        if ( i<nx_p ) {
+            // Electric field Ey^(p,d)
+            field_real* Ey = &(*Ey2D)(i,0);
+            field_real* Jy = rhoJ_zero ? zero_row.data() : &(*Jy2D)(i,0);
+            field_real* Bz = &(*Bz2D)(i,0);
+            field_real* Bz_i = &(*Bz2D)(i+1,0);
+            #pragma omp simd
+            for (unsigned int j=0 ; j<ny_d ; j++) {
+                Ey[j] += -timestep*Jy[j] - dt_ov_dx * ( Bz_i[j] - Bz[j] );
+            }
+            // Electric field Ez^(p,p)
+            field_real* Ez = &(*Ez2D)(i,0);
+            field_real* Jz = rhoJ_zero ? zero_row.data() : &(*Jz2D)(i,0);
+            field_real* Bx = &(*Bx2D)(i,0);
+            field_real* By = &(*By2D)(i,0);
+            field_real* By_i = &(*By2D)(i+1,0);
+            #pragma omp simd
+            for (unsigned int j=0 ; j<ny_p ; j++) {
+                Ez[j] += -timestep*Jz[j]
+                +        dt_ov_dx * ( By_i[j] - By[j] )
+                -        dt_ov_dy * ( Bx[j+1] - Bx[j] );
+            }
+        }
+        
+        // Magnetic field Bx^(p,d)
+        if ( i<nx_p ) {
+            field_real* Bx   = &(*Bx2D)  (i,0);
+            field_real* Bx_m = &(*Bx2D_m)(i,0);
+            field_real* Ez = &(*Ez2D)(i,0);
+            unsigned int jmin, jmax;
+            centeredRow( i, nx_p, ny_d, jmin, jmax );
+            Bx_m[0] = Bx[0];
+            #pragma omp simd
+            for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+                double B = Bx[j];
+                Bx[j] -= dt_ov_dy * ( Ez[j] - Ez[j-1] );
+                Bx_m[j] = ( j>=jmin && j<jmax ) ? ( Bx[j] + B )*0.5 : B;
+            }
+            Bx_m[ny_d-1] = Bx[ny_d-1];
+        }
+        
+        field_real* By   = &(*By2D)  (i,0);
+        field_real* By_m = &(*By2D_m)(i,0);
+        field_real* Bz   = &(*Bz2D)  (i,0);
+        field_real* Bz_m = &(*Bz2D_m)(i,0);
+        if ( i>0 && i<nx_d-1 ) {
+            // Magnetic field By^(d,p)
+            field_real* Ez = &(*Ez2D)(i,0);
+            field_real* Ez_i = &(*Ez2D)(i-1,0);
+            unsigned int jmin, jmax;
+            centeredRow( i, nx_d, ny_p, jmin, jmax );
+            #pragma omp simd
+            for (unsigned int j=0 ; j<ny_p ; j++) {
+                double B = By[j];
+                By[j] += dt_ov_dx * ( Ez[j] - Ez_i[j] );
+                By_m[j] = ( j>=jmin && j<jmax ) ? ( By[j] + B )*0.5 : B;
+            }
+            // Magnetic field Bz^(d,d)
+            field_real* Ex = &(*Ex2D)(i,0);
+            field_real* Ey = &(*Ey2D)(i,0);
+            field_real* Ey_i = &(*Ey2D)(i-1,0);
+            centeredRow( i, nx_d, ny_d, jmin, jmax );
+            Bz_m[0] = Bz[0];
+            #pragma omp simd
+            for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+                double B = Bz[j];
+                Bz[j] += dt_ov_dy * ( Ex[j] - Ex[j-1] )
+                -        dt_ov_dx * ( Ey[j] - Ey_i[j] );
+                Bz_m[j] = ( j>=jmin && j<jmax ) ? ( Bz[j] + B )*0.5 : B;
+            }
+            Bz_m[ny_d-1] = Bz[ny_d-1];
+        } else {
+            memcpy( By_m, By, ny_p*sizeof(field_real) );
+            memcpy( Bz_m, Bz, ny_d*sizeof(field_real) );
+        }
+        
+    } // end for i
+    
+}//END solveMaxwellFused
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Center the Magnetic Fields on the planes modified by the boundary conditions (see solveMaxwellFused)
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn2D::centerMagneticFieldsOnBorders()
+{
+    Field2D* B2D  [3] = { static_cast<Field2D*>(Bx_),  static_cast<Field2D*>(By_),  static_cast<Field2D*>(Bz_)  };
+    Field2D* B2D_m[3] = { static_cast<Field2D*>(Bx_m), static_cast<Field2D*>(By_m), static_cast<Field2D*>(Bz_m) };
+    
+    // Bx^(p,d), By^(d,p) and Bz^(d,d)
+    for (unsigned int c=0 ; c<3 ; c++) {
+        unsigned int nx = c==0 ? nx_p : nx_d;
+        unsigned int ny = c==1 ? ny_p : ny_d;
+        for (unsigned int i=0 ; i<nx ; i++) {
+            field_real* B   = &(*B2D  [c])(i,0);
+            field_real* B_m = &(*B2D_m[c])(i,0);
+            // Points outside [jmin,jmax[, not centered by solveMaxwellFused
+            unsigned int jmin, jmax;
+            centeredRow( i, nx, ny, jmin, jmax );
+            for (unsigned int j=0 ; j<jmin ; j++) {
+                B_m[j] = ( B[j] + B_m[j] )*0.5;
+            }
+            for (unsigned int j=jmax ; j<ny ; j++) {
+                B_m[j] = ( B[j] + B_m[j] )*0.5;
+            }
+        }
+    }
+    
+}//END centerMagneticFieldsOnBorders
+
+
 
 // Create a new field
 Field * ElectroMagn2D::createField(string fieldname)
@@ -52,6 +52,12 @@ public:
     //! Method used to center the Magnetic fields (used to push the particles)
     void centerMagneticFields();
     
+    //! Method used to solve Maxwell-Ampere and Maxwell-Faraday (Yee) in a single pass, and to center B
+    void solveMaxwellFused();
+    
+    //! Method used to center the Magnetic fields on the planes modified by the boundary conditions
+    void centerMagneticFieldsOnBorders();
+    
     //! Method used to apply a single-pass binomial filter on currents
     void binomialCurrentFilter();
     
@@ -108,6 +114,21 @@ public:
     
 private:
     
+    //! Row of zeros read by solveMaxwellFused instead of the currents when rhoJ_zero
+    std::vector<field_real> zero_row;
+    
+    //! Range [jmin,jmax[ of the points of the row i of a magnetic field of nx*ny nodes outside the planes
+    //! modified by the boundary conditions (bc_width), empty if the whole row is in these planes
+    inline void centeredRow( unsigned int i, unsigned int nx, unsigned int ny, unsigned int &jmin, unsigned int &jmax ) {
+        if ( i<bc_width[0][0] || i>=nx-bc_width[0][1] ) {
+            jmin = 0;
+            jmax = 0;
+        } else {
+            jmin = bc_width[1][0];
+            jmax = ny-bc_width[1][1];
+        }
+    }
+    
     //! from smpi is xmin
     const bool isXmin;
     
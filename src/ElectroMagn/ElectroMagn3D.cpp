@@ -49,6 +49,9 @@ isZmin(patch->isZmin())
     dt_ov_dz = timestep/dz;
     dz_ov_dt = 1.0/dt_ov_dz;
     
+    // The Yee solver is fused with Maxwell-Ampere (see solveMaxwellFused)
+    fusedMaxwell = ( params.maxwell_sol == "Yee" );
+    
     // ----------------------
     // Electromagnetic fields
     // ----------------------
@@ -186,6 +189,9 @@ isZmin(patch->isZmin())
     dt_ov_dz = timestep/dz;
     dz_ov_dt = 1.0/dt_ov_dz;
     
+    // The Yee solver is fused with Maxwell-Ampere (see solveMaxwellFused)
+    fusedMaxwell = ( params.maxwell_sol == "Yee" );
+    
     // ----------------------
     // Electromagnetic fields
     // ----------------------
@@ -500,13 +506,13 @@ void ElectroMagn3D::saveMagneticFields()
     Field3D* Bz3D_m = static_cast<Field3D*>(Bz_m);
     
     // Magnetic field Bx^(p,d,d)
-    memcpy(&((*Bx3D_m)(0,0,0)), &((*Bx3D)(0,0,0)),nx_p*ny_d*nz_d*sizeof(double) );
+    memcpy(&((*Bx3D_m)(0,0,0)), &((*Bx3D)(0,0,0)),nx_p*ny_d*nz_d*sizeof(field_real) );
     
     // Magnetic field By^(d,p,d)
-    memcpy(&((*By3D_m)(0,0,0)), &((*By3D)(0,0,0)),nx_d*ny_p*nz_d*sizeof(double) );
+    memcpy(&((*By3D_m)(0,0,0)), &((*By3D)(0,0,0)),nx_d*ny_p*nz_d*sizeof(field_real) );
     
     // Magnetic field Bz^(d,d,p)
-    memcpy(&((*Bz3D_m)(0,0,0)), &((*Bz3D)(0,0,0)),nx_d*ny_d*nz_p*sizeof(double) );
+    memcpy(&((*Bz3D_m)(0,0,0)), &((*Bz3D)(0,0,0)),nx_d*ny_d*nz_p*sizeof(field_real) );
     
 }//END saveMagneticFields
 
@@ -619,6 +625,183 @@ void ElectroMagn3D::centerMagneticFields()
 }//END centerMagneticFields
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Solve Maxwell-Ampere and Maxwell-Faraday (Yee) in a single pass, B_m being set to B at time n+1/2
+// (or n on the planes modified by the boundary conditions)
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn3D::solveMaxwellFused()
+{
+    // Static-cast of the fields
+    Field3D* Ex3D = static_cast<Field3D*>(Ex_);
+    Field3D* Ey3D = static_cast<Field3D*>(Ey_);
+    Field3D* Ez3D = static_cast<Field3D*>(Ez_);
+    Field3D* Bx3D = static_cast<Field3D*>(Bx_);
+    Field3D* By3D = static_cast<Field3D*>(By_);
+    Field3D* Bz3D = static_cast<Field3D*>(Bz_);
+    Field3D* Bx3D_m = static_cast<Field3D*>(Bx_m);
+    Field3D* By3D_m = static_cast<Field3D*>(By_m);
+    Field3D* Bz3D_m = static_cast<Field3D*>(Bz_m);
+    Field3D* Jx3D = static_cast<Field3D*>(Jx_);
+    Field3D* Jy3D = static_cast<Field3D*>(Jy_);
+    Field3D* Jz3D = static_cast<Field3D*>(Jz_);
+    // Without currents, J is read from a row of zeros, which stays in cache (-timestep*0. being -0., E is unchanged)
+    if ( rhoJ_zero && zero_row.size()<nz_d )
+        zero_row.resize( nz_d, 0. );
+    
+    // The rows (i,j) are swept by blocks of rows in j, then in increasing i and j. E in row (i,j) needs B in rows
+    // (i,j), (i+1,j) and (i,j+1), not advanced yet, and B in row (i,j) needs E in rows (i,j), (i-1,j) and (i,j-1),
+    // already advanced: the results are those of solveMaxwellAmpere followed by MF_Solver3D_Yee
+    unsigned int block_rows = max( fused_block_size/nz_d, 1u );
+    for (unsigned int jblock=0 ; jblock<ny_d ; jblock+=block_rows) {
+        unsigned int jend = min( jblock+block_rows, ny_d );
+        for (unsigned int i=0 ; i<nx_d ; i++) {
+            for (unsigned int j=jblock ; j<jend ; j++) {
+                
+                // Electric field Ex^(d,p,p)
+                if ( j<ny_p ) {
+                    field_real* Ex = &(*Ex3D)(i,j,0);
+                    field_real* Jx = rhoJ_zero ? zero_row.data() : &(*Jx3D)(i,j,0);
+                    field_real* By = &(*By3D)(i,j,0);
+                    field_real* Bz = &(*Bz3D)(i,j,0);
+                    field_real* Bz_j = &(*Bz3D)(i,j+1,0);
+                    #pragma omp simd
+                    for (unsigned int k=0 ; k<nz_p ; k++) {
+                        Ex[k] += -timestep*Jx[k] + dt_ov_dy * ( Bz_j[k] - Bz[k] ) - dt_ov_dz * ( By[k+1] - By[k] );
+                    }
+                }
+                if ( i<nx_p ) {
+                    // Electric field Ey^(p,d,p)
+                    field_real* Ey = &(*Ey3D)(i,j,0);
+                    field_real* Jy = rhoJ_zero ? zero_row.data() : &(*Jy3D)(i,j,0);
+                    field_real* Bx = &(*Bx3D)(i,j,0);
+                    field_real* Bz = &(*Bz3D)(i,j,0);
+                    field_real* Bz_i = &(*Bz3D)(i+1,j,0);
+                    #pragma omp simd
+                    for (unsigned int k=0 ; k<nz_p ; k++) {
+                        Ey[k] += -timestep*Jy[k] - dt_ov_dx * ( Bz_i[k] - Bz[k] ) + dt_ov_dz * ( Bx[k+1] - Bx[k] );
+                    }
+                    // Electric field Ez^(p,p,d)
+                    if ( j<ny_p ) {
+                        field_real* Ez = &(*Ez3D)(i,j,0);
+                        field_real* Jz = rhoJ_zero ? zero_row.data() : &(*Jz3D)(i,j,0);
+                        field_real* By = &(*By3D)(i,j,0);
+                        field_real* By_i = &(*By3D)(i+1,j,0);
+                        field_real* Bx_j = &(*Bx3D)(i,j+1,0);
+                        #pragma omp simd
+                        for (unsigned int k=0 ; k<nz_d ; k++) {
+                            Ez[k] += -timestep*Jz[k] + dt_ov_dx * ( By_i[k] - By[k] ) - dt_ov_dy * ( Bx_j[k] - Bx[k] );
+                        }
+                    }
+                }
+                
+                // Magnetic field Bx^(p,d,d)
+                if ( i<nx_p ) {
+                    field_real* Bx   = &(*Bx3D)  (i,j,0);
+                    field_real* Bx_m = &(*Bx3D_m)(i,j,0);
+                    if ( j>0 && j<ny_d-1 ) {
+                        field_real* Ey = &(*Ey3D)(i,j,0);
+                        field_real* Ez = &(*Ez3D)(i,j,0);
+                        field_real* Ez_j = &(*Ez3D)(i,j-1,0);
+                        unsigned int kmin, kmax;
+                        centeredRow( i, nx_p, j, ny_d, nz_d, kmin, kmax );
+                        Bx_m[0] = Bx[0];
+                        #pragma omp simd
+                        for (unsigned int k=1 ; k<nz_d-1 ; k++) {
+                            double B = Bx[k];
+                            Bx[k] += -dt_ov_dy * ( Ez[k] - Ez_j[k] ) + dt_ov_dz * ( Ey[k] - Ey[k-1] );
+                            Bx_m[k] = ( k>=kmin && k<kmax ) ? ( Bx[k] + B )*0.5 : B;
+                        }
+                        Bx_m[nz_d-1] = Bx[nz_d-1];
+                    } else {
+                        memcpy( Bx_m, Bx, nz_d*sizeof(field_real) );
+                    }
+                }
+                
+                // Magnetic field By^(d,p,d)
+                if ( j<ny_p ) {
+                    field_real* By   = &(*By3D)  (i,j,0);
+                    field_real* By_m = &(*By3D_m)(i,j,0);
+                    if ( i>0 && i<nx_d-1 ) {
+                        field_real* Ex = &(*Ex3D)(i,j,0);
+                        field_real* Ez = &(*Ez3D)(i,j,0);
+                        field_real* Ez_i = &(*Ez3D)(i-1,j,0);
+                        unsigned int kmin, kmax;
+                        centeredRow( i, nx_d, j, ny_p, nz_d, kmin, kmax );
+                        By_m[0] = By[0];
+                        #pragma omp simd
+                        for (unsigned int k=1 ; k<nz_d-1 ; k++) {
+                            double B = By[k];
+                            By[k] += -dt_ov_dz * ( Ex[k] - Ex[k-1] ) + dt_ov_dx * ( Ez[k] - Ez_i[k] );
+                            By_m[k] = ( k>=kmin && k<kmax ) ? ( By[k] + B )*0.5 : B;
+                        }
+                        By_m[nz_d-1] = By[nz_d-1];
+                    } else {
+                        memcpy( By_m, By, nz_d*sizeof(field_real) );
+                    }
+                }
+                
+                // Magnetic field Bz^(d,d,p)
+                {
+                    field_real* Bz   = &(*Bz3D)  (i,j,0);
+                    field_real* Bz_m = &(*Bz3D_m)(i,j,0);
+                    if ( i>0 && i<nx_d-1 && j>0 && j<ny_d-1 ) {
+                        field_real* Ex = &(*Ex3D)(i,j,0);
+                        field_real* Ex_j = &(*Ex3D)(i,j-1,0);
+                        field_real* Ey = &(*Ey3D)(i,j,0);
+                        field_real* Ey_i = &(*Ey3D)(i-1,j,0);
+                        unsigned int kmin, kmax;
+                        centeredRow( i, nx_d, j, ny_d, nz_p, kmin, kmax );
+                        #pragma omp simd
+                        for (unsigned int k=0 ; k<nz_p ; k++) {
+                            double B = Bz[k];
+                            Bz[k] += -dt_ov_dx * ( Ey[k] - Ey_i[k] ) + dt_ov_dy * ( Ex[k] - Ex_j[k] );
+                            Bz_m[k] = ( k>=kmin && k<kmax ) ? ( Bz[k] + B )*0.5 : B;
+                        }
+                    } else {
+                        memcpy( Bz_m, Bz, nz_p*sizeof(field_real) );
+                    }
+                }
+                
+            } // end for j
+        } // end for i
+    } // end for jblock
+    
+}//END solveMaxwellFused
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Center the Magnetic Fields on the planes modified by the boundary conditions (see solveMaxwellFused)
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn3D::centerMagneticFieldsOnBorders()
+{
+    Field3D* B3D  [3] = { static_cast<Field3D*>(Bx_),  static_cast<Field3D*>(By_),  static_cast<Field3D*>(Bz_)  };
+    Field3D* B3D_m[3] = { static_cast<Field3D*>(Bx_m), static_cast<Field3D*>(By_m), static_cast<Field3D*>(Bz_m) };
+    
+    // Bx^(p,d,d), By^(d,p,d) and Bz^(d,d,p)
+    for (unsigned int c=0 ; c<3 ; c++) {
+        unsigned int nx = c==0 ? nx_p : nx_d;
+        unsigned int ny = c==1 ? ny_p : ny_d;
+        unsigned int nz = c==2 ? nz_p : nz_d;
+        for (unsigned int i=0 ; i<nx ; i++) {
+            for (unsigned int j=0 ; j<ny ; j++) {
+                field_real* B   = &(*B3D  [c])(i,j,0);
+                field_real* B_m = &(*B3D_m[c])(i,j,0);
+                // Points outside [kmin,kmax[, not centered by solveMaxwellFused
+                unsigned int kmin, kmax;
+                centeredRow( i, nx, j, ny, nz, kmin, kmax );
+                for (unsigned int k=0 ; k<kmin ; k++) {
+                    B_m[k] = ( B[k] + B_m[k] )*0.5;
+                }
+                for (unsigned int k=kmax ; k<nz ; k++) {
+                    B_m[k] = ( B[k] + B_m[k] )*0.5;
+                }
+            }
+        }
+    }
+    
+}//END centerMagneticFieldsOnBorders
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Apply a single pass binomial filter on currents
 // ---------------------------------------------------------------------------------------------------------------------
@@ -48,6 +48,16 @@ public:
     //! Method used to center the Magnetic fields (used to push the particles)
     void centerMagneticFields();
     
+    //! Method used to solve Maxwell-Ampere and Maxwell-Faraday (Yee) in a single pass, and to center B
+    void solveMaxwellFused();
+    
+    //! Method used to center the Magnetic fields on the planes modified by the boundary conditions
+    void centerMagneticFieldsOnBorders();
+    
+    //! Number of nodes of the (j,k) slices of the blocks swept by solveMaxwellFused
+    //! (the slices of two consecutive planes of all the fields should fit in the L2 cache)
+    static const unsigned int fused_block_size = 1024;
+    
     //! Method used to apply a single-pass binomial filter on currents
     void binomialCurrentFilter();
     
@@ -119,6 +129,22 @@ public:
         
 private:
     
+    //! Row of zeros read by solveMaxwellFused instead of the currents when rhoJ_zero
+    std::vector<field_real> zero_row;
+    
+    //! Range [kmin,kmax[ of the points of the row (i,j) of a magnetic field of nx*ny*nz nodes outside the planes
+    //! modified by the boundary conditions (bc_width), empty if the whole row is in these planes
+    inline void centeredRow( unsigned int i, unsigned int nx, unsigned int j, unsigned int ny, unsigned int nz,
+                             unsigned int &kmin, unsigned int &kmax ) {
+        if ( i<bc_width[0][0] || i>=nx-bc_width[0][1] || j<bc_width[1][0] || j>=ny-bc_width[1][1] ) {
+            kmin = 0;
+            kmax = 0;
+        } else {
+            kmin = bc_width[2][0];
+            kmax = nz-bc_width[2][1];
+        }
+    }
+    
     //! from smpi is xmin
     const bool isXmin;
     
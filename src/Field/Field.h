@@ -95,18 +95,18 @@ public:
     //! Linearized diags
     unsigned int globalDims_;
     //! pointer to the linearized array
-    double* data_;
+    field_real* data_;
     
-    inline double* data() {return data_;}
+    inline field_real* data() {return data_;}
     //! reference access to the linearized array (with check in DEBUG mode)
-    inline double& operator () (unsigned int i)
+    inline field_real& operator () (unsigned int i)
     {
         DEBUGEXEC(if (i>=globalDims_) ERROR(name << " Out of limits "<< i << " < " <<dims_[0] ));
         DEBUGEXEC(if (!std::isfinite(data_[i])) ERROR(name << " Not finite "<< i << " = " << data_[i]));
         return data_[i];
     };
     //! access to the linearized array (with check in DEBUG mode)
-    inline double operator () (unsigned int i) const
+    inline field_real operator () (unsigned int i) const
     {
         DEBUGEXEC(if (i>=globalDims_) ERROR(name << " Out of limits "<< i));
         DEBUGEXEC(if (!std::isfinite(data_[i])) ERROR(name << " Not finite "<< i << " = " << data_[i]));
@@ -128,7 +128,7 @@ public:
     
     
     //! 2D reference access to the linearized array (with check in DEBUG mode)
-    inline double& operator () (unsigned int i,unsigned int j)
+    inline field_real& operator () (unsigned int i,unsigned int j)
     {
         int unsigned idx = i*dims_[1]+j;
         DEBUGEXEC(if (idx>=globalDims_) ERROR("Out of limits & "<< i << " " << j));
@@ -136,7 +136,7 @@ public:
         return data_[idx];
     };
     //! 2D access to the linearized array (with check in DEBUG mode)
-    inline double operator () (unsigned int i, unsigned int j) const
+    inline field_real operator () (unsigned int i, unsigned int j) const
     {
         unsigned int idx = i*dims_[1]+j;
         DEBUGEXEC(if (idx>=globalDims_) ERROR("Out of limits "<< i << " " << j));
@@ -145,7 +145,7 @@ public:
     };
 
     //! 3D reference access to the linearized array (with check in DEBUG mode)
-    inline double& operator () (unsigned int i,unsigned int j, unsigned k)
+    inline field_real& operator () (unsigned int i,unsigned int j, unsigned k)
     {
 	unsigned int idx = i*dims_[1]*dims_[2]+j*dims_[2]+k;
         DEBUGEXEC(if (idx>=globalDims_) ERROR("Out of limits & "<< i << " " << j));
@@ -153,7 +153,7 @@ public:
         return data_[idx];
     };
     //! 3D access to the linearized array (with check in DEBUG mode)
-    inline double operator () (unsigned int i, unsigned int j, unsigned k) const
+    inline field_real operator () (unsigned int i, unsigned int j, unsigned k) const
     {
 	unsigned int idx = i*dims_[1]*dims_[2]+j*dims_[2]+k;
         DEBUGEXEC(if (idx>=globalDims_) ERROR("Out of limits "<< i << " " << j));
@@ -69,7 +69,7 @@ void Field1D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[ dims_[0] ];
+    data_ = new field_real[ dims_[0] ];
     //! \todo{change to memset (JD)}
     for (unsigned int i=0; i<dims_[0]; i++) data_[i]=0.0;
     
@@ -113,7 +113,7 @@ void Field1D::allocateDims(unsigned int mainDim, bool isPrimal)
     for ( unsigned int j=0 ; j<dims_.size() ; j++ )
         dims_[j] += isDual_[j];
     
-    data_ = new double[ dims_[0] ];
+    data_ = new field_real[ dims_[0] ];
     //! \todo{change to memset (JD)}
     for (unsigned int i=0; i<dims_[0]; i++) data_[i]=0.0;
     
@@ -135,8 +135,8 @@ void Field1D::dump(vector<unsigned int> dims)
 // ---------------------------------------------------------------------------------------------------------------------
 void Field1D::shift_x(unsigned int delta)
 {
-    memmove( &(data_[0]), &(data_[delta]), (dims_[0]-delta)*sizeof(double) );
-    //memset ( &(data_[dims_[0]-delta]), 0, delta*sizeof(double));
+    memmove( &(data_[0]), &(data_[delta]), (dims_[0]-delta)*sizeof(field_real) );
+    //memset ( &(data_[dims_[0]-delta]), 0, delta*sizeof(field_real));
     for (int i=dims_[0]-delta;i<(int)dims_[0];i++) data_[i] = 0.;
 
 }
@@ -79,10 +79,10 @@ void Field2D::allocateDims()
 
     isDual_.resize( dims_.size(), 0 );
 
-    data_ = new double[dims_[0]*dims_[1]];
+    data_ = new field_real[dims_[0]*dims_[1]];
     //! \todo{check row major order!!! (JD)}
 
-    data_2D= new double*[dims_[0]];
+    data_2D= new field_real*[dims_[0]];
     for (unsigned int i=0; i<dims_[0]; i++) {
         data_2D[i] = data_ + i*dims_[1];
         for (unsigned int j=0; j<dims_[1]; j++) data_2D[i][j] = 0.0;
@@ -130,10 +130,10 @@ void Field2D::allocateDims(unsigned int mainDim, bool isPrimal )
     for ( unsigned int j=0 ; j<dims_.size() ; j++ )
         dims_[j] += isDual_[j];
     
-    data_ = new double[dims_[0]*dims_[1]];
+    data_ = new field_real[dims_[0]*dims_[1]];
     //! \todo{check row major order!!! (JD)}
     
-    data_2D= new double*[dims_[0]];
+    data_2D= new field_real*[dims_[0]];
     for (unsigned int i=0; i<dims_[0]; i++)  {
         data_2D[i] = data_ + i*dims_[1];
         for (unsigned int j=0; j<dims_[1]; j++) data_2D[i][j] = 0.0;
@@ -158,8 +158,8 @@ void Field2D::dump(vector<unsigned int> dims)
 // ---------------------------------------------------------------------------------------------------------------------
 void Field2D::shift_x(unsigned int delta)
 {
-    memmove( &(data_2D[0][0]), &(data_2D[delta][0]), (dims_[1]*dims_[0]-delta*dims_[1])*sizeof(double) );
-    memset( &(data_2D[dims_[0]-delta][0]), 0, delta*dims_[1]*sizeof(double));
+    memmove( &(data_2D[0][0]), &(data_2D[delta][0]), (dims_[1]*dims_[0]-delta*dims_[1])*sizeof(field_real) );
+    memset( &(data_2D[dims_[0]-delta][0]), 0, delta*dims_[1]*sizeof(field_real));
     
 }
 
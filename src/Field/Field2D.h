@@ -54,26 +54,26 @@ public:
     virtual void shift_x(unsigned int delta);
     
     //! Overloading of the () operator allowing to set a new value for the (i,j) element of a Field2D
-    inline double& operator () (unsigned int i,unsigned int j) {
+    inline field_real& operator () (unsigned int i,unsigned int j) {
         DEBUGEXEC(if (i>=dims_[0] || j>=dims_[1]) ERROR(name << "Out of limits ("<< i << "," << j << ")  > (" <<dims_[0] << "," <<dims_[1] << ")" ));
         DEBUGEXEC(if (!std::isfinite(data_2D[i][j])) ERROR(name << " Not finite "<< i << "," << j << " = " << data_2D[i][j]));
         return data_2D[i][j];
     };
     
-    /*inline double& operator () (unsigned int i) {
+    /*inline field_real& operator () (unsigned int i) {
         DEBUGEXEC(if (i>=dims_[0]*dims_[1]) ERROR("Out of limits & "<< i));
         DEBUGEXEC(if (!std::isfinite(data_2D[i])) ERROR("Not finite "<< i));
         return data_2D[i];
     };*/
     
     //! Overloading of the () operator allowing to get the value of the (i,j) element of a Field2D
-    inline double operator () (unsigned int i,unsigned int j) const {
+    inline field_real operator () (unsigned int i,unsigned int j) const {
         DEBUGEXEC(if (i>=dims_[0] || j>=dims_[1]) ERROR(name << "Out of limits "<< i << " " << j));
         DEBUGEXEC(if (!std::isfinite(data_2D[i][j])) ERROR(name << "Not finite "<< i << "," << j << " = " << data_2D[i][j]));
         return data_2D[i][j];
     };
     
-    /*inline double operator () (unsigned int i) const {
+    /*inline field_real operator () (unsigned int i) const {
         DEBUGEXEC(if (i>=dims_[0]*dims_[1]) ERROR("Out of limits & "<< i));
         DEBUGEXEC(if (!std::isfinite(data_2D[i])) ERROR("Not finite "<< i));
         return data_2D[i];
@@ -81,7 +81,7 @@ public:
     
     //double** data_;
     //! this will present the data as a 2d matrix
-    double **data_2D;
+    field_real **data_2D;
     
     virtual double norm2(unsigned int istart[3][2], unsigned int bufsize[3][2]);
 
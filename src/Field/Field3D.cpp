@@ -77,12 +77,12 @@ void Field3D::allocateDims() {
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    data_ = new field_real[dims_[0]*dims_[1]*dims_[2]];
     //! \todo{check row major order!!!}
-    data_3D= new double**[dims_[0]];
+    data_3D= new field_real**[dims_[0]];
     for (unsigned int i=0; i<dims_[0]; i++)
     {
-        data_3D[i]= new double*[dims_[1]];
+        data_3D[i]= new field_real*[dims_[1]];
         for (unsigned int j=0; j<dims_[1]; j++)
         {
             data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
@@ -135,12 +135,12 @@ void Field3D::allocateDims(unsigned int mainDim, bool isPrimal ) {
     for ( unsigned int j=0 ; j<dims_.size() ; j++ )
         dims_[j] += isDual_[j];
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    data_ = new field_real[dims_[0]*dims_[1]*dims_[2]];
     //! \todo{check row major order!!!}
-    data_3D= new double**[dims_[0]*dims_[1]];
+    data_3D= new field_real**[dims_[0]*dims_[1]];
     for (unsigned int i=0; i<dims_[0]; i++)
     {
-        data_3D[i]= new double*[dims_[1]];
+        data_3D[i]= new field_real*[dims_[1]];
         for (unsigned int j=0; j<dims_[1]; j++)
         {
             data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
@@ -169,8 +169,8 @@ void Field3D::dump(vector<unsigned int> dims)
 // ---------------------------------------------------------------------------------------------------------------------
 void Field3D::shift_x(unsigned int delta)
 {
-    memmove( &(data_3D[0][0][0]), &(data_3D[delta][0][0]), (dims_[2]*dims_[1]*dims_[0]-delta*dims_[2]*dims_[1])*sizeof(double) );
-    memset( &(data_3D[dims_[0]-delta][0][0]), 0, delta*dims_[1]*dims_[2]*sizeof(double));
+    memmove( &(data_3D[0][0][0]), &(data_3D[delta][0][0]), (dims_[2]*dims_[1]*dims_[0]-delta*dims_[2]*dims_[1])*sizeof(field_real) );
+    memset( &(data_3D[dims_[0]-delta][0][0]), 0, delta*dims_[1]*dims_[2]*sizeof(field_real));
 
 }
 
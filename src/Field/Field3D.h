@@ -55,13 +55,13 @@ public:
     virtual void shift_x(unsigned int delta);
     
     //! Overloading of the () operator allowing to set a new value for the (i,j,k) element of a Field3D
-    inline double& operator () (unsigned int i,unsigned int j,unsigned int k)
+    inline field_real& operator () (unsigned int i,unsigned int j,unsigned int k)
     {
         DEBUGEXEC(if (i>=dims_[0] || j>=dims_[1] || k >= dims_[2]) ERROR(name << "Out of limits & "<< i << " " << j << " " << k));
         return data_3D[i][j][k];
     };
     
-    /*inline double& operator () (unsigned int i)
+    /*inline field_real& operator () (unsigned int i)
     {
         DEBUGEXEC(if (i>=dims_[0]*dims_[1]*dims_[2]) ERROR("Out of limits & "<< i));
         DEBUGEXEC(if (!std::isfinite(data_3D[i])) ERROR("Not finite "<< i));
@@ -69,12 +69,12 @@ public:
     };*/
     
     //! Overloading of the () operator allowing to get the value for the (i,j,k) element of a Field3D
-    inline double operator () (unsigned int i,unsigned int j,unsigned int k) const {
+    inline field_real operator () (unsigned int i,unsigned int j,unsigned int k) const {
         DEBUGEXEC(if (i>=dims_[0] || j>=dims_[1] || k >= dims_[2]) ERROR(name << "Out of limits "<< i << " " << j << " " << k));
         return data_3D[i][j][k];
     };
     
-    /*inline double operator () (unsigned int i) const {
+    /*inline field_real operator () (unsigned int i) const {
         DEBUGEXEC(if (i>=dims_[0]*dims_[1]*dims_[2]) ERROR("Out of limits & "<< i));
         DEBUGEXEC(if (!std::isfinite(data_3D[i])) ERROR("Not finite "<< i));
         return data_3D[i];
@@ -86,7 +86,7 @@ public:
 
 
     //! this will present the data as a 3d matrix
-    double ***data_3D;
+    field_real ***data_3D;
     virtual double norm2(unsigned int istart[3][2], unsigned int bufsize[3][2]);
 
 private:
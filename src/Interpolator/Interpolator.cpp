@@ -5,6 +5,8 @@
 
 #include "Params.h"
 #include "Patch.h"
+#include "ElectroMagn.h"
+#include "SmileiMPI.h"
 
 using namespace std;
 
@@ -12,3 +14,36 @@ Interpolator::Interpolator(Params &params, Patch* patch)
 {
 }
 
+void Interpolator::fill_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim)
+{
+    Field* fields[6] = { EMfields->Ex_, EMfields->Ey_, EMfields->Ez_, EMfields->Bx_m, EMfields->By_m, EMfields->Bz_m };
+    
+    // Nodes of the tile along each dimension
+    unsigned int n[3] = { b_dim[0], 1, 1 };
+    for (unsigned int i=1 ; i<EMfields->dimDual.size() ; i++)
+        n[i] = EMfields->dimDual[i];
+    
+    std::vector<field_real> &tile = smpi->dynamics_EBtile[ithread];
+    tile.resize( 6*n[0]*n[1]*n[2] );
+    
+    unsigned int start = ibin*clrw;
+    for (unsigned int c=0 ; c<6 ; c++) {
+        // Dimensions of the component (1 along the missing dimensions)
+        unsigned int d[3] = { fields[c]->dims_[0], 1, 1 };
+        for (unsigned int i=1 ; i<fields[c]->dims_.size() ; i++)
+            d[i] = fields[c]->dims_[i];
+        field_real* data = fields[c]->data();
+        unsigned int nrows = min( n[0], d[0]-start );
+        for (unsigned int i=0 ; i<nrows ; i++)
+            for (unsigned int j=0 ; j<d[1] ; j++)
+                for (unsigned int k=0 ; k<d[2] ; k++)
+                    tile[ ((i*n[1]+j)*n[2]+k)*6 + c ] = data[ ((start+i)*d[1]+j)*d[2]+k ];
+    }
+    
+    smpi->dynamics_EBtile_start[ithread] = start;
+}
+
+void Interpolator::close_bin_tile(SmileiMPI* smpi, int ithread)
+{
+    smpi->dynamics_EBtile_start[ithread] = -1;
+}
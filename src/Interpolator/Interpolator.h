@@ -19,10 +19,21 @@ public:
     Interpolator(Params& params, Patch* patch);
     virtual ~Interpolator() {};
     
-    virtual void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread) = 0;
+    //! Interpolate the fields for particles istart to iend-1, stored in the smpi buffers from index istart-ipart_ref
+    virtual void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0) = 0;
     
     virtual void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc, LocalFields* JLoc, double* RhoLoc) = 0;
 
+    //! Next interpolations of bin ibin read the fields from a tile of thread ithread (no-op if the interpolator has no tiled gather)
+    virtual void open_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim) {};
+    //! Next interpolations read the fields from the patch arrays
+    void close_bin_tile(SmileiMPI* smpi, int ithread);
+
+protected:
+    //! Copy b_dim[0] rows (first index) of E and B from row ibin*clrw in the tile of thread ithread, the six components
+    //! being interleaved node by node on the dual grid (the primal components are padded)
+    void fill_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim);
+
 private:
 
 };//END class
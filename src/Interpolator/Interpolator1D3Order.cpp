@@ -23,7 +23,7 @@ Interpolator1D3Order::Interpolator1D3Order(Params &params, Patch* patch) : Inter
     with size nstp_x and space step stp_x_inv at the position
     xj and return the value fxj
 ***********************************************************************/
-void Interpolator1D3Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc)
+void Interpolator1D3Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc)
 {
     double xjn, xi2, xi3;
     
@@ -55,9 +55,9 @@ void Interpolator1D3Order::operator() (ElectroMagn* EMfields, Particles &particl
     
     id_ -= index_domain_begin;
     
-    (*ELoc).x = compute(coeffd_, Ex1D,   id_);  
-    (*BLoc).y = compute(coeffd_, By1D_m, id_);  
-    (*BLoc).z = compute(coeffd_, Bz1D_m, id_);  
+    *(ELoc+0*nparts) = compute(coeffd_, Ex1D,   id_);  
+    *(BLoc+1*nparts) = compute(coeffd_, By1D_m, id_);  
+    *(BLoc+2*nparts) = compute(coeffd_, Bz1D_m, id_);  
     
     // Primal Grid : Ey, Ez, Bx
     // ------------------------
@@ -74,9 +74,9 @@ void Interpolator1D3Order::operator() (ElectroMagn* EMfields, Particles &particl
     
     ip_ -= index_domain_begin;
     
-    (*ELoc).y = compute(coeffp_, Ey1D,   ip_);  
-    (*ELoc).z = compute(coeffp_, Ez1D,   ip_);  
-    (*BLoc).x = compute(coeffp_, Bx1D_m, ip_);
+    *(ELoc+1*nparts) = compute(coeffp_, Ey1D,   ip_);  
+    *(ELoc+2*nparts) = compute(coeffp_, Ez1D,   ip_);  
+    *(BLoc+0*nparts) = compute(coeffp_, Bx1D_m, ip_);
     
     
 }//END Interpolator1D3Order
@@ -104,20 +104,21 @@ void Interpolator1D3Order::operator() (ElectroMagn* EMfields, Particles &particl
     (*JLoc).x = compute(coeffd_, Jx1D,  id_);  
     
 }
-void Interpolator1D3Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
+void Interpolator1D3Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
+    double* Epart = smpi->dynamics_Epart[ithread].data();
+    double* Bpart = smpi->dynamics_Bpart[ithread].data();
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
     std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
     std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
     
     //Loop on bin particles
     for (int ipart=istart ; ipart<iend; ipart++ ) {
         //Interpolation on current particle
-        (*this)(EMfields, particles, ipart, &(*Epart)[ipart], &(*Bpart)[ipart]);
+        (*this)(EMfields, particles, ipart, nparts, &Epart[ipart-ipart_ref], &Bpart[ipart-ipart_ref]);
         //Buffering of iol and delta
-        (*iold)[ipart] = ip_;
-        (*delta)[ipart] = xi;
+        (*iold)[ipart-ipart_ref] = ip_;
+        (*delta)[ipart-ipart_ref] = xi;
     }
     
 }
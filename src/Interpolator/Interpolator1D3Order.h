@@ -9,8 +9,10 @@ public:
     Interpolator1D3Order(Params&, Patch*);
     ~Interpolator1D3Order() override final{};
     
-    inline void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc);
-    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)override final;
+    //! Interpolate E and B for particle ipart: component i is stored at ELoc[i*nparts] and BLoc[i*nparts]
+    
+    inline void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc);
+    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0)override final;
     void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc, LocalFields* JLoc, double* RhoLoc) override final;
     
     inline double compute( double* coeff, Field1D* f, int idx) {
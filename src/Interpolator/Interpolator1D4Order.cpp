@@ -31,7 +31,7 @@ Interpolator1D4Order::Interpolator1D4Order(Params &params, Patch *patch) : Inter
 // ---------------------------------------------------------------------------------------------------------------------
 // 2nd Order Interpolation of the fields at a the particle position (3 nodes are used)
 // ---------------------------------------------------------------------------------------------------------------------
-void Interpolator1D4Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc)
+void Interpolator1D4Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc)
 {
     
     // Variable declaration
@@ -67,9 +67,9 @@ void Interpolator1D4Order::operator() (ElectroMagn* EMfields, Particles &particl
     
     id_ -= index_domain_begin;
     
-    (*ELoc).x = compute(coeffd_, Ex1D,   id_);  
-    (*BLoc).y = compute(coeffd_, By1D_m, id_);  
-    (*BLoc).z = compute(coeffd_, Bz1D_m, id_);  
+    *(ELoc+0*nparts) = compute(coeffd_, Ex1D,   id_);  
+    *(BLoc+1*nparts) = compute(coeffd_, By1D_m, id_);  
+    *(BLoc+2*nparts) = compute(coeffd_, Bz1D_m, id_);  
     
     // --------------------------------------------------------
     // Interpolate the fields from the Primal grid : Ey, Ez, Bx
@@ -89,9 +89,9 @@ void Interpolator1D4Order::operator() (ElectroMagn* EMfields, Particles &particl
     
     ip_ -= index_domain_begin;
     
-    (*ELoc).y = compute(coeffp_, Ey1D,   ip_);  
-    (*ELoc).z = compute(coeffp_, Ez1D,   ip_);  
-    (*BLoc).x = compute(coeffp_, Bx1D_m, ip_);
+    *(ELoc+1*nparts) = compute(coeffp_, Ey1D,   ip_);  
+    *(ELoc+2*nparts) = compute(coeffp_, Ez1D,   ip_);  
+    *(BLoc+0*nparts) = compute(coeffp_, Bx1D_m, ip_);
 
 
 
@@ -101,7 +101,7 @@ void Interpolator1D4Order::operator() (ElectroMagn* EMfields, Particles &particl
     
     // Interpolate E, B
     // Compute coefficient for ipart position    (*this)(EMfields, particles, ipart, ELoc, BLoc);
-    (*this)(EMfields, particles, ipart, ELoc, BLoc);
+    (*this)(EMfields, particles, ipart, 1, &(ELoc->x), &(BLoc->x));
     
     // Static cast of the electromagnetic fields
     Field1D* Jx1D     = static_cast<Field1D*>(EMfields->Jx_);
@@ -122,20 +122,21 @@ void Interpolator1D4Order::operator() (ElectroMagn* EMfields, Particles &particl
     (*JLoc).x = compute(coeffd_, Jx1D,  id_);  
     
 }
-void Interpolator1D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
+void Interpolator1D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
+    double* Epart = smpi->dynamics_Epart[ithread].data();
+    double* Bpart = smpi->dynamics_Bpart[ithread].data();
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
     std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
     std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
     
     //Loop on bin particles
     for (int ipart=istart ; ipart<iend; ipart++ ) {
         //Interpolation on current particle
-        (*this)(EMfields, particles, ipart, &(*Epart)[ipart], &(*Bpart)[ipart]);
+        (*this)(EMfields, particles, ipart, nparts, &Epart[ipart-ipart_ref], &Bpart[ipart-ipart_ref]);
         //Buffering of iol and delta
-        (*iold)[ipart] = ip_;
-        (*delta)[ipart] = xjmxi;
+        (*iold)[ipart-ipart_ref] = ip_;
+        (*delta)[ipart-ipart_ref] = xjmxi;
     }
 
 }
@@ -1,6 +1,7 @@
 #include "Interpolator2D2Order.h"
 
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 
 #include "ElectroMagn.h"
@@ -24,7 +25,7 @@ Interpolator2D2Order::Interpolator2D2Order(Params &params, Patch *patch) : Inter
 // ---------------------------------------------------------------------------------------------------------------------
 // 2nd Order Interpolation of the fields at a the particle position (3 nodes are used)
 // ---------------------------------------------------------------------------------------------------------------------
-void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc)
+void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc)
 {
     // Static cast of the electromagnetic fields
     Field2D* Ex2D = static_cast<Field2D*>(EMfields->Ex_);
@@ -86,32 +87,32 @@ void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particl
     // -------------------------
     // Interpolation of Ex^(d,p)
     // -------------------------
-    (*ELoc).x =  compute( &coeffxd_[1], &coeffyp_[1], Ex2D, id_, jp_);
+    *(ELoc+0*nparts) =  compute( &coeffxd_[1], &coeffyp_[1], Ex2D, id_, jp_);
     
     // -------------------------
     // Interpolation of Ey^(p,d)
     // -------------------------
-    (*ELoc).y = compute( &coeffxp_[1], &coeffyd_[1], Ey2D, ip_, jd_);
+    *(ELoc+1*nparts) = compute( &coeffxp_[1], &coeffyd_[1], Ey2D, ip_, jd_);
     
     // -------------------------
     // Interpolation of Ez^(p,p)
     // -------------------------
-    (*ELoc).z = compute( &coeffxp_[1], &coeffyp_[1], Ez2D, ip_, jp_);
+    *(ELoc+2*nparts) = compute( &coeffxp_[1], &coeffyp_[1], Ez2D, ip_, jp_);
     
     // -------------------------
     // Interpolation of Bx^(p,d)
     // -------------------------
-    (*BLoc).x = compute( &coeffxp_[1], &coeffyd_[1], Bx2D, ip_, jd_);
+    *(BLoc+0*nparts) = compute( &coeffxp_[1], &coeffyd_[1], Bx2D, ip_, jd_);
     
     // -------------------------
     // Interpolation of By^(d,p)
     // -------------------------
-    (*BLoc).y = compute( &coeffxd_[1], &coeffyp_[1], By2D, id_, jp_);
+    *(BLoc+1*nparts) = compute( &coeffxd_[1], &coeffyp_[1], By2D, id_, jp_);
     
     // -------------------------
     // Interpolation of Bz^(d,d)
     // -------------------------
-    (*BLoc).z = compute( &coeffxd_[1], &coeffyd_[1], Bz2D, id_, jd_);
+    *(BLoc+2*nparts) = compute( &coeffxd_[1], &coeffyd_[1], Bz2D, id_, jd_);
 
 } // END Interpolator2D2Order
 
@@ -119,7 +120,7 @@ void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particl
 {
     // Interpolate E, B
     // Compute coefficient for ipart position
-    (*this)(EMfields, particles, ipart, ELoc, BLoc);
+    (*this)(EMfields, particles, ipart, 1, &(ELoc->x), &(BLoc->x));
     
     // Static cast of the electromagnetic fields
     Field2D* Jx2D = static_cast<Field2D*>(EMfields->Jx_);
@@ -150,22 +151,117 @@ void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particl
 
 }
 
-void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
+// ---------------------------------------------------------------------------------------------------------------------
+// 2nd Order Interpolation of the fields for a batch of particles (same arithmetic as the single particle version)
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator2D2Order::batch(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nparts, double* Epart, double* Bpart, int* iold, double* delta, field_real* tile, int tile_start)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
-    std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
-    std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
-    
-    //Loop on bin particles
-    for (int ipart=istart ; ipart<iend; ipart++ ) {
-        //Interpolation on current particle
-        (*this)(EMfields, particles, ipart, &(*Epart)[ipart], &(*Bpart)[ipart]);
-        //Buffering of iol and delta
-        (*iold)[ipart*2] = ip_;
-        (*iold)[ipart*2+1] = jp_;
-        (*delta)[ipart*2] = deltax;
-        (*delta)[ipart*2+1] = deltay;
+    int n = iend-istart;
+
+    // Indexes of the central nodes and interpolation coefficients, stored by node for the whole batch
+    double delta_x[batch_size], delta_y[batch_size];
+    int ip[batch_size], id[batch_size], jp[batch_size], jd[batch_size];
+    double coeffxp[3*batch_size], coeffxd[3*batch_size], coeffyp[3*batch_size], coeffyd[3*batch_size];
+
+    double* position_x = &( particles.position(0, 0) );
+    double* position_y = &( particles.position(1, 0) );
+
+    // Indexes of the central nodes (global), computed apart so that the loops have no inner branch
+    #pragma omp simd
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        double xpn = position_x[istart+ipart]*dx_inv_;
+        double ypn = position_y[istart+ipart]*dy_inv_;
+        ip[ipart] = round(xpn);
+        id[ipart] = round(xpn+0.5);
+        jp[ipart] = round(ypn);
+        jd[ipart] = round(ypn+0.5);
+    }
+
+    #pragma omp simd
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        // Normalized particle position
+        double xpn = position_x[istart+ipart]*dx_inv_;
+        double ypn = position_y[istart+ipart]*dy_inv_;
+        int ipl = ip[ipart], idl = id[ipart], jpl = jp[ipart], jdl = jd[ipart];
+
+        double delta2;
+        double dx = xpn - (double)idl + 0.5;
+        delta2  = dx*dx;
+        coeffxd[ipart]              = 0.5 * (delta2-dx+0.25);
+        coeffxd[ipart+batch_size]   = 0.75 - delta2;
+        coeffxd[ipart+2*batch_size] = 0.5 * (delta2+dx+0.25);
+
+        dx      = xpn - (double)ipl;
+        delta2  = dx*dx;
+        coeffxp[ipart]              = 0.5 * (delta2-dx+0.25);
+        coeffxp[ipart+batch_size]   = 0.75 - delta2;
+        coeffxp[ipart+2*batch_size] = 0.5 * (delta2+dx+0.25);
+
+        double dy = ypn - (double)jdl + 0.5;
+        delta2  = dy*dy;
+        coeffyd[ipart]              = 0.5 * (delta2-dy+0.25);
+        coeffyd[ipart+batch_size]   = 0.75 - delta2;
+        coeffyd[ipart+2*batch_size] = 0.5 * (delta2+dy+0.25);
+
+        dy      = ypn - (double)jpl;
+        delta2  = dy*dy;
+        coeffyp[ipart]              = 0.5 * (delta2-dy+0.25);
+        coeffyp[ipart+batch_size]   = 0.75 - delta2;
+        coeffyp[ipart+2*batch_size] = 0.5 * (delta2+dy+0.25);
+
+        // First index for summation
+        ip[ipart] = ipl - i_domain_begin;
+        id[ipart] = idl - i_domain_begin;
+        jp[ipart] = jpl - j_domain_begin;
+        jd[ipart] = jdl - j_domain_begin;
+
+        // Last primal delta, buffered for the projector
+        delta_x[ipart] = dx;
+        delta_y[ipart] = dy;
+    }
+
+    //Buffering of iol and delta (strided stores, kept out of the loop above so that it vectorizes)
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        iold[ipart*2+0]  = ip[ipart];
+        iold[ipart*2+1]  = jp[ipart];
+        delta[ipart*2+0] = delta_x[ipart];
+        delta[ipart*2+1] = delta_y[ipart];
+    }
+
+    // Ex^(d,p), Ey^(p,d), Ez^(p,p), Bx^(p,d), By^(d,p), Bz^(d,d)
+    Field* fields[6] = { EMfields->Ex_, EMfields->Ey_, EMfields->Ez_, EMfields->Bx_m, EMfields->By_m, EMfields->Bz_m };
+    double* res[6]   = { Epart, Epart+nparts, Epart+2*nparts, Bpart, Bpart+nparts, Bpart+2*nparts };
+    double* cx[6]    = { coeffxd, coeffxp, coeffxp, coeffxp, coeffxd, coeffxd };
+    double* cy[6]    = { coeffyp, coeffyd, coeffyp, coeffyd, coeffyp, coeffyd };
+    int* ix[6]       = { id, ip, ip, ip, id, id };
+    int* iy[6]       = { jp, jd, jp, jd, jp, jd };
+    
+    // In the tile, the six components are interleaved on the dual grid
+    int ny = EMfields->dimDual[1];
+    for (int c=0 ; c<6 ; c++) {
+        if (tile)
+            gather( cx[c], cy[c], tile+c, 6*ny, 6, tile_start, ix[c], iy[c], n, res[c] );
+        else
+            gather( cx[c], cy[c], fields[c]->data(), fields[c]->dims_[1], 1, 0, ix[c], iy[c], n, res[c] );
+    }
+
+} // END Interpolator2D2Order::batch
+
+void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
+{
+    double* Epart = smpi->dynamics_Epart[ithread].data();
+    double* Bpart = smpi->dynamics_Bpart[ithread].data();
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
+    int* iold = smpi->dynamics_iold[ithread].data();
+    double* delta = smpi->dynamics_deltaold[ithread].data();
+    int tile_start = smpi->dynamics_EBtile_start[ithread];
+    field_real* tile = tile_start >= 0 ? smpi->dynamics_EBtile[ithread].data() : NULL;
+    
+    //Loop on bin particles, by batches
+    for (int ipart=istart ; ipart<iend; ipart+=batch_size ) {
+        int ipart_end = min( ipart+batch_size, iend );
+        batch(EMfields, particles, ipart, ipart_end, nparts, &Epart[ipart-ipart_ref], &Bpart[ipart-ipart_ref],
+              &iold[(ipart-ipart_ref)*2], &delta[(ipart-ipart_ref)*2], tile, tile_start);
     }
 
 }
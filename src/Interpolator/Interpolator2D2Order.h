@@ -16,8 +16,10 @@ public:
     Interpolator2D2Order(Params&, Patch*);
     ~Interpolator2D2Order() override final {};
 
-    inline void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc);
-    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread) override final ;
+    //! Interpolate E and B for particle ipart: component i is stored at ELoc[i*nparts] and BLoc[i*nparts]
+
+    inline void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc);
+    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0) override final ;
     void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc, LocalFields* JLoc, double* RhoLoc) override final ;
 
     inline double compute( double* coeffx, double* coeffy, Field2D* f, int idx, int idy) {
@@ -31,6 +33,34 @@ public:
         return interp_res;
     };  
 
+    //! Number of particles interpolated together by the vectorized gather
+    static const int batch_size = 32;
+
+    //! Interpolate E and B for particles istart to iend-1 (at most batch_size particles, buffered from Epart[0]):
+    //! the shape coefficients of the whole batch are computed first, then each component is gathered in a single loop,
+    //! from the patch arrays or from the bin tile if any (tile != NULL, its first row being tile_start)
+    void batch(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nparts, double* Epart, double* Bpart, int* iold, double* delta, field_real* tile, int tile_start);
+
+    //! Gather a field for n particles, coefficients being stored by node (coeffx[iloc*batch_size+ipart]):
+    //! node (i,j) is read at data[(i-i0)*sx+j*sy]
+    inline void gather( double* coeffx, double* coeffy, field_real* data, int sx, int sy, int i0, int* idx, int* idy, int n, double* res) {
+        #pragma omp simd
+        for (int ipart=0 ; ipart<n ; ipart++) {
+            double interp_res(0.);
+            for (int iloc=0 ; iloc<3 ; iloc++) {
+                for (int jloc=0 ; jloc<3 ; jloc++) {
+                    interp_res += coeffx[iloc*batch_size+ipart] * coeffy[jloc*batch_size+ipart] * data[(idx[ipart]-i0+iloc-1)*sx + (idy[ipart]+jloc-1)*sy];
+                }
+            }
+            res[ipart] = interp_res;
+        }
+    };
+
+    //! Interpolation of the next bins from the tile of E and B
+    void open_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim) override final {
+        fill_bin_tile(EMfields, smpi, ithread, ibin, clrw, b_dim);
+    };
+
 private:
     // Last prim index computed
     int ip_, jp_;
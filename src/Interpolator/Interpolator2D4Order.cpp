@@ -40,7 +40,7 @@ Interpolator2D4Order::Interpolator2D4Order(Params &params, Patch *patch) : Inter
 // ---------------------------------------------------------------------------------------------------------------------
 // 2nd Order Interpolation of the fields at a the particle position (3 nodes are used)
 // ---------------------------------------------------------------------------------------------------------------------
-void Interpolator2D4Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc)
+void Interpolator2D4Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc)
 {
     // Static cast of the electromagnetic fields
     Field2D* Ex2D = static_cast<Field2D*>(EMfields->Ex_);
@@ -119,32 +119,32 @@ void Interpolator2D4Order::operator() (ElectroMagn* EMfields, Particles &particl
     // -------------------------
     // Interpolation of Ex^(d,p)
     // -------------------------
-    (*ELoc).x =  compute( &coeffxd_[2], &coeffyp_[2], Ex2D, id_, jp_);
+    *(ELoc+0*nparts) =  compute( &coeffxd_[2], &coeffyp_[2], Ex2D, id_, jp_);
     
     // -------------------------
     // Interpolation of Ey^(p,d)
     // -------------------------
-    (*ELoc).y = compute( &coeffxp_[2], &coeffyd_[2], Ey2D, ip_, jd_);
+    *(ELoc+1*nparts) = compute( &coeffxp_[2], &coeffyd_[2], Ey2D, ip_, jd_);
     
     // -------------------------
     // Interpolation of Ez^(p,p)
     // -------------------------
-    (*ELoc).z = compute( &coeffxp_[2], &coeffyp_[2], Ez2D, ip_, jp_);
+    *(ELoc+2*nparts) = compute( &coeffxp_[2], &coeffyp_[2], Ez2D, ip_, jp_);
     
     // -------------------------
     // Interpolation of Bx^(p,d)
     // -------------------------
-    (*BLoc).x = compute( &coeffxp_[2], &coeffyd_[2], Bx2D, ip_, jd_);
+    *(BLoc+0*nparts) = compute( &coeffxp_[2], &coeffyd_[2], Bx2D, ip_, jd_);
     
     // -------------------------
     // Interpolation of By^(d,p)
     // -------------------------
-    (*BLoc).y = compute( &coeffxd_[2], &coeffyp_[2], By2D, id_, jp_);
+    *(BLoc+1*nparts) = compute( &coeffxd_[2], &coeffyp_[2], By2D, id_, jp_);
     
     // -------------------------
     // Interpolation of Bz^(d,d)
     // -------------------------
-    (*BLoc).z = compute( &coeffxd_[2], &coeffyd_[2], Bz2D, id_, jd_);
+    *(BLoc+2*nparts) = compute( &coeffxd_[2], &coeffyd_[2], Bz2D, id_, jd_);
 
 } // END Interpolator2D4Order
 
@@ -152,7 +152,7 @@ void Interpolator2D4Order::operator() (ElectroMagn* EMfields, Particles &particl
 {
     // Interpolate E, B
     // Compute coefficient for ipart position
-    (*this)(EMfields, particles, ipart, ELoc, BLoc);
+    (*this)(EMfields, particles, ipart, 1, &(ELoc->x), &(BLoc->x));
     
     // Static cast of the electromagnetic fields
     Field2D* Jx2D = static_cast<Field2D*>(EMfields->Jx_);
@@ -183,22 +183,23 @@ void Interpolator2D4Order::operator() (ElectroMagn* EMfields, Particles &particl
     (*RhoLoc) = compute( &coeffxp_[2], &coeffyp_[2], Rho2D, ip_, jp_);
     
 }
-void Interpolator2D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
+void Interpolator2D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
+    double* Epart = smpi->dynamics_Epart[ithread].data();
+    double* Bpart = smpi->dynamics_Bpart[ithread].data();
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
     std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
     std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
     
     //Loop on bin particles
     for (int ipart=istart ; ipart<iend; ipart++ ) {
         //Interpolation on current particle
-        (*this)(EMfields, particles, ipart, &(*Epart)[ipart], &(*Bpart)[ipart]);
+        (*this)(EMfields, particles, ipart, nparts, &Epart[ipart-ipart_ref], &Bpart[ipart-ipart_ref]);
         //Buffering of iol and delta
-        (*iold)[ipart*2] = ip_;
-        (*iold)[ipart*2+1] = jp_;
-        (*delta)[ipart*2] = deltax;
-        (*delta)[ipart*2+1] = deltay;
+        (*iold)[(ipart-ipart_ref)*2] = ip_;
+        (*iold)[(ipart-ipart_ref)*2+1] = jp_;
+        (*delta)[(ipart-ipart_ref)*2] = deltax;
+        (*delta)[(ipart-ipart_ref)*2+1] = deltay;
     }
 
 }
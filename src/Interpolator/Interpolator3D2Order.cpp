@@ -1,6 +1,7 @@
 #include "Interpolator3D2Order.h"
 
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 
 #include "ElectroMagn.h"
@@ -25,7 +26,7 @@ Interpolator3D2Order::Interpolator3D2Order(Params &params, Patch *patch) : Inter
 // ---------------------------------------------------------------------------------------------------------------------
 // 2nd Order Interpolation of the fields at a the particle position (3 nodes are used)
 // ---------------------------------------------------------------------------------------------------------------------
-void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc)
+void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc)
 {
     // Static cast of the electromagnetic fields
     Field3D* Ex3D = static_cast<Field3D*>(EMfields->Ex_);
@@ -104,32 +105,32 @@ void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particl
     // -------------------------
     // Interpolation of Ex^(d,p,p)
     // -------------------------
-    (*ELoc).x = compute( &coeffxd_[1], &coeffyp_[1], &coeffzp_[1], Ex3D, id_, jp_, kp_);
+    *(ELoc+0*nparts) = compute( &coeffxd_[1], &coeffyp_[1], &coeffzp_[1], Ex3D, id_, jp_, kp_);
 
     // -------------------------
     // Interpolation of Ey^(p,d,p)
     // -------------------------
-    (*ELoc).y = compute( &coeffxp_[1], &coeffyd_[1], &coeffzp_[1], Ey3D, ip_, jd_, kp_);
+    *(ELoc+1*nparts) = compute( &coeffxp_[1], &coeffyd_[1], &coeffzp_[1], Ey3D, ip_, jd_, kp_);
 
     // -------------------------
     // Interpolation of Ez^(p,p,d)
     // -------------------------
-    (*ELoc).z = compute( &coeffxp_[1], &coeffyp_[1], &coeffzd_[1], Ez3D, ip_, jp_, kd_);
+    *(ELoc+2*nparts) = compute( &coeffxp_[1], &coeffyp_[1], &coeffzd_[1], Ez3D, ip_, jp_, kd_);
 
     // -------------------------
     // Interpolation of Bx^(p,d,d)
     // -------------------------
-    (*BLoc).x = compute( &coeffxp_[1], &coeffyd_[1], &coeffzd_[1], Bx3D, ip_, jd_, kd_);
+    *(BLoc+0*nparts) = compute( &coeffxp_[1], &coeffyd_[1], &coeffzd_[1], Bx3D, ip_, jd_, kd_);
 
     // -------------------------
     // Interpolation of By^(d,p,d)
     // -------------------------
-    (*BLoc).y = compute( &coeffxd_[1], &coeffyp_[1], &coeffzd_[1], By3D, id_, jp_, kd_);
+    *(BLoc+1*nparts) = compute( &coeffxd_[1], &coeffyp_[1], &coeffzd_[1], By3D, id_, jp_, kd_);
 
     // -------------------------
     // Interpolation of Bz^(d,d,p)
     // -------------------------
-    (*BLoc).z = compute( &coeffxd_[1], &coeffyd_[1], &coeffzp_[1], Bz3D, id_, jd_, kp_);
+    *(BLoc+2*nparts) = compute( &coeffxd_[1], &coeffyd_[1], &coeffzp_[1], Bz3D, id_, jd_, kp_);
 
 } // END Interpolator3D2Order
 
@@ -137,7 +138,7 @@ void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particl
 {
     // Interpolate E, B
     // Compute coefficient for ipart position
-    (*this)(EMfields, particles, ipart, ELoc, BLoc);
+    (*this)(EMfields, particles, ipart, 1, &(ELoc->x), &(BLoc->x));
 
     // Static cast of the electromagnetic fields
     Field3D* Jx3D = static_cast<Field3D*>(EMfields->Jx_);
@@ -168,24 +169,144 @@ void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particl
 
 }
 
-void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
+// ---------------------------------------------------------------------------------------------------------------------
+// 2nd Order Interpolation of the fields for a batch of particles (same arithmetic as the single particle version)
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator3D2Order::batch(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nparts, double* Epart, double* Bpart, int* iold, double* delta, field_real* tile, int tile_start)
+{
+    int n = iend-istart;
+
+    // Indexes of the central nodes and interpolation coefficients, stored by node for the whole batch
+    double delta_x[batch_size], delta_y[batch_size], delta_z[batch_size];
+    int ip[batch_size], id[batch_size], jp[batch_size], jd[batch_size], kp[batch_size], kd[batch_size];
+    double coeffxp[3*batch_size], coeffxd[3*batch_size];
+    double coeffyp[3*batch_size], coeffyd[3*batch_size];
+    double coeffzp[3*batch_size], coeffzd[3*batch_size];
+
+    double* position_x = &( particles.position(0, 0) );
+    double* position_y = &( particles.position(1, 0) );
+    double* position_z = &( particles.position(2, 0) );
+
+    // Indexes of the central nodes (global), computed apart so that the loops have no inner branch
+    #pragma omp simd
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        double xpn = position_x[istart+ipart]*dx_inv_;
+        double ypn = position_y[istart+ipart]*dy_inv_;
+        double zpn = position_z[istart+ipart]*dz_inv_;
+        ip[ipart] = round(xpn);
+        id[ipart] = round(xpn+0.5);
+        jp[ipart] = round(ypn);
+        jd[ipart] = round(ypn+0.5);
+        kp[ipart] = round(zpn);
+        kd[ipart] = round(zpn+0.5);
+    }
+
+    #pragma omp simd
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        // Normalized particle position
+        double xpn = position_x[istart+ipart]*dx_inv_;
+        double ypn = position_y[istart+ipart]*dy_inv_;
+        double zpn = position_z[istart+ipart]*dz_inv_;
+        int ipl = ip[ipart], idl = id[ipart], jpl = jp[ipart], jdl = jd[ipart], kpl = kp[ipart], kdl = kd[ipart];
+
+        double delta2;
+        double dx = xpn - (double)idl + 0.5;
+        delta2  = dx*dx;
+        coeffxd[ipart]              = 0.5 * (delta2-dx+0.25);
+        coeffxd[ipart+batch_size]   = 0.75 - delta2;
+        coeffxd[ipart+2*batch_size] = 0.5 * (delta2+dx+0.25);
+
+        dx      = xpn - (double)ipl;
+        delta2  = dx*dx;
+        coeffxp[ipart]              = 0.5 * (delta2-dx+0.25);
+        coeffxp[ipart+batch_size]   = 0.75 - delta2;
+        coeffxp[ipart+2*batch_size] = 0.5 * (delta2+dx+0.25);
+
+        double dy = ypn - (double)jdl + 0.5;
+        delta2  = dy*dy;
+        coeffyd[ipart]              = 0.5 * (delta2-dy+0.25);
+        coeffyd[ipart+batch_size]   = 0.75 - delta2;
+        coeffyd[ipart+2*batch_size] = 0.5 * (delta2+dy+0.25);
+
+        dy      = ypn - (double)jpl;
+        delta2  = dy*dy;
+        coeffyp[ipart]              = 0.5 * (delta2-dy+0.25);
+        coeffyp[ipart+batch_size]   = 0.75 - delta2;
+        coeffyp[ipart+2*batch_size] = 0.5 * (delta2+dy+0.25);
+
+        double dz = zpn - (double)kdl + 0.5;
+        delta2  = dz*dz;
+        coeffzd[ipart]              = 0.5 * (delta2-dz+0.25);
+        coeffzd[ipart+batch_size]   = 0.75 - delta2;
+        coeffzd[ipart+2*batch_size] = 0.5 * (delta2+dz+0.25);
+
+        dz      = zpn - (double)kpl;
+        delta2  = dz*dz;
+        coeffzp[ipart]              = 0.5 * (delta2-dz+0.25);
+        coeffzp[ipart+batch_size]   = 0.75 - delta2;
+        coeffzp[ipart+2*batch_size] = 0.5 * (delta2+dz+0.25);
+
+        // First index for summation
+        ip[ipart] = ipl - i_domain_begin;
+        id[ipart] = idl - i_domain_begin;
+        jp[ipart] = jpl - j_domain_begin;
+        jd[ipart] = jdl - j_domain_begin;
+        kp[ipart] = kpl - k_domain_begin;
+        kd[ipart] = kdl - k_domain_begin;
+
+        // Last primal delta, buffered for the projector
+        delta_x[ipart] = dx;
+        delta_y[ipart] = dy;
+        delta_z[ipart] = dz;
+    }
+
+    //Buffering of iol and delta (strided stores, kept out of the loop above so that it vectorizes)
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        iold[ipart*3+0]  = ip[ipart];
+        iold[ipart*3+1]  = jp[ipart];
+        iold[ipart*3+2]  = kp[ipart];
+        delta[ipart*3+0] = delta_x[ipart];
+        delta[ipart*3+1] = delta_y[ipart];
+        delta[ipart*3+2] = delta_z[ipart];
+    }
+
+    // Ex^(d,p,p), Ey^(p,d,p), Ez^(p,p,d), Bx^(p,d,d), By^(d,p,d), Bz^(d,d,p)
+    Field* fields[6] = { EMfields->Ex_, EMfields->Ey_, EMfields->Ez_, EMfields->Bx_m, EMfields->By_m, EMfields->Bz_m };
+    double* res[6]   = { Epart, Epart+nparts, Epart+2*nparts, Bpart, Bpart+nparts, Bpart+2*nparts };
+    double* cx[6]    = { coeffxd, coeffxp, coeffxp, coeffxp, coeffxd, coeffxd };
+    double* cy[6]    = { coeffyp, coeffyd, coeffyp, coeffyd, coeffyp, coeffyd };
+    double* cz[6]    = { coeffzp, coeffzp, coeffzd, coeffzd, coeffzd, coeffzp };
+    int* ix[6]       = { id, ip, ip, ip, id, id };
+    int* iy[6]       = { jp, jd, jp, jd, jp, jd };
+    int* iz[6]       = { kp, kp, kd, kd, kd, kp };
+    
+    // In the tile, the six components are interleaved on the dual grid
+    int ny = EMfields->dimDual[1];
+    int nz = EMfields->dimDual[2];
+    for (int c=0 ; c<6 ; c++) {
+        if (tile)
+            gather( cx[c], cy[c], cz[c], tile+c, 6*ny*nz, 6*nz, 6, tile_start, ix[c], iy[c], iz[c], n, res[c] );
+        else
+            gather( cx[c], cy[c], cz[c], fields[c]->data(), fields[c]->dims_[1]*fields[c]->dims_[2], fields[c]->dims_[2], 1, 0, ix[c], iy[c], iz[c], n, res[c] );
+    }
+
+} // END Interpolator3D2Order::batch
+
+void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
-    std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
-    std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
-
-    //Loop on bin particles
-    for (int ipart=istart ; ipart<iend; ipart++ ) {
-        //Interpolation on current particle
-        (*this)(EMfields, particles, ipart, &(*Epart)[ipart], &(*Bpart)[ipart]);
-        //Buffering of iol and delta
-        (*iold)[ipart*3]    = ip_;
-        (*iold)[ipart*3+1]  = jp_;
-        (*iold)[ipart*3+2]  = kp_;
-        (*delta)[ipart*3]   = deltax;
-        (*delta)[ipart*3+1] = deltay;
-        (*delta)[ipart*3+2] = deltaz;
+    double* Epart = smpi->dynamics_Epart[ithread].data();
+    double* Bpart = smpi->dynamics_Bpart[ithread].data();
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
+    int* iold = smpi->dynamics_iold[ithread].data();
+    double* delta = smpi->dynamics_deltaold[ithread].data();
+    int tile_start = smpi->dynamics_EBtile_start[ithread];
+    field_real* tile = tile_start >= 0 ? smpi->dynamics_EBtile[ithread].data() : NULL;
+
+    //Loop on bin particles, by batches
+    for (int ipart=istart ; ipart<iend; ipart+=batch_size ) {
+        int ipart_end = min( ipart+batch_size, iend );
+        batch(EMfields, particles, ipart, ipart_end, nparts, &Epart[ipart-ipart_ref], &Bpart[ipart-ipart_ref],
+              &iold[(ipart-ipart_ref)*3], &delta[(ipart-ipart_ref)*3], tile, tile_start);
     }
 
 }
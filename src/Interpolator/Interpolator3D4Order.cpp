@@ -0,0 +1,262 @@
+#include "Interpolator3D4Order.h"
+
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+#include "Particles.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Creator for Interpolator3D4Order
+// ---------------------------------------------------------------------------------------------------------------------
+Interpolator3D4Order::Interpolator3D4Order(Params &params, Patch *patch) : Interpolator3D(params, patch)
+{
+
+    dx_inv_ = 1.0/params.cell_length[0];
+    dy_inv_ = 1.0/params.cell_length[1];
+    dz_inv_ = 1.0/params.cell_length[2];
+
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 4th Order Interpolation of the fields at a the particle position (5 nodes are used)
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator3D4Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc)
+{
+    // Static cast of the electromagnetic fields
+    Field3D* Ex3D = static_cast<Field3D*>(EMfields->Ex_);
+    Field3D* Ey3D = static_cast<Field3D*>(EMfields->Ey_);
+    Field3D* Ez3D = static_cast<Field3D*>(EMfields->Ez_);
+    Field3D* Bx3D = static_cast<Field3D*>(EMfields->Bx_m);
+    Field3D* By3D = static_cast<Field3D*>(EMfields->By_m);
+    Field3D* Bz3D = static_cast<Field3D*>(EMfields->Bz_m);
+
+
+    // Normalized particle position
+    double xpn = particles.position(0, ipart)*dx_inv_;
+    double ypn = particles.position(1, ipart)*dy_inv_;
+    double zpn = particles.position(2, ipart)*dz_inv_;
+
+
+    // Indexes of the central nodes
+    ip_ = round(xpn);
+    id_ = round(xpn+0.5);
+    jp_ = round(ypn);
+    jd_ = round(ypn+0.5);
+    kp_ = round(zpn);
+    kd_ = round(zpn+0.5);
+
+
+    // Calculation of the coefficients for interpolation
+    deltax = xpn - (double)id_ + 0.5;
+    ShapeFunction::quartic( deltax, coeffxd_, 1 );
+    deltax = xpn - (double)ip_;
+    ShapeFunction::quartic( deltax, coeffxp_, 1 );
+
+    deltay = ypn - (double)jd_ + 0.5;
+    ShapeFunction::quartic( deltay, coeffyd_, 1 );
+    deltay = ypn - (double)jp_;
+    ShapeFunction::quartic( deltay, coeffyp_, 1 );
+
+    deltaz = zpn - (double)kd_ + 0.5;
+    ShapeFunction::quartic( deltaz, coeffzd_, 1 );
+    deltaz = zpn - (double)kp_;
+    ShapeFunction::quartic( deltaz, coeffzp_, 1 );
+
+
+    // First index for summation
+    ip_ = ip_ - i_domain_begin;
+    id_ = id_ - i_domain_begin;
+    jp_ = jp_ - j_domain_begin;
+    jd_ = jd_ - j_domain_begin;
+    kp_ = kp_ - k_domain_begin;
+    kd_ = kd_ - k_domain_begin;
+
+
+    // -------------------------
+    // Interpolation of Ex^(d,p,p)
+    // -------------------------
+    *(ELoc+0*nparts) = compute( &coeffxd_[2], &coeffyp_[2], &coeffzp_[2], Ex3D, id_, jp_, kp_);
+
+    // -------------------------
+    // Interpolation of Ey^(p,d,p)
+    // -------------------------
+    *(ELoc+1*nparts) = compute( &coeffxp_[2], &coeffyd_[2], &coeffzp_[2], Ey3D, ip_, jd_, kp_);
+
+    // -------------------------
+    // Interpolation of Ez^(p,p,d)
+    // -------------------------
+    *(ELoc+2*nparts) = compute( &coeffxp_[2], &coeffyp_[2], &coeffzd_[2], Ez3D, ip_, jp_, kd_);
+
+    // -------------------------
+    // Interpolation of Bx^(p,d,d)
+    // -------------------------
+    *(BLoc+0*nparts) = compute( &coeffxp_[2], &coeffyd_[2], &coeffzd_[2], Bx3D, ip_, jd_, kd_);
+
+    // -------------------------
+    // Interpolation of By^(d,p,d)
+    // -------------------------
+    *(BLoc+1*nparts) = compute( &coeffxd_[2], &coeffyp_[2], &coeffzd_[2], By3D, id_, jp_, kd_);
+
+    // -------------------------
+    // Interpolation of Bz^(d,d,p)
+    // -------------------------
+    *(BLoc+2*nparts) = compute( &coeffxd_[2], &coeffyd_[2], &coeffzp_[2], Bz3D, id_, jd_, kp_);
+
+} // END Interpolator3D4Order
+
+void Interpolator3D4Order::operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc, LocalFields* JLoc, double* RhoLoc)
+{
+    // Interpolate E, B
+    // Compute coefficient for ipart position
+    (*this)(EMfields, particles, ipart, 1, &(ELoc->x), &(BLoc->x));
+
+    // Static cast of the electromagnetic fields
+    Field3D* Jx3D = static_cast<Field3D*>(EMfields->Jx_);
+    Field3D* Jy3D = static_cast<Field3D*>(EMfields->Jy_);
+    Field3D* Jz3D = static_cast<Field3D*>(EMfields->Jz_);
+    Field3D* Rho3D= static_cast<Field3D*>(EMfields->rho_);
+
+
+    // -------------------------
+    // Interpolation of Jx^(d,p,p)
+    // -------------------------
+    (*JLoc).x = compute( &coeffxd_[2], &coeffyp_[2], &coeffzp_[2], Jx3D, id_, jp_, kp_);
+
+    // -------------------------
+    // Interpolation of Jy^(p,d,p)
+    // -------------------------
+    (*JLoc).y = compute( &coeffxp_[2], &coeffyd_[2], &coeffzp_[2], Jy3D, ip_, jd_, kp_);
+
+    // -------------------------
+    // Interpolation of Jz^(p,p,d)
+    // -------------------------
+    (*JLoc).z = compute( &coeffxp_[2], &coeffyp_[2], &coeffzd_[2], Jz3D, ip_, jp_, kd_);
+
+    // -------------------------
+    // Interpolation of Rho^(p,p,p)
+    // -------------------------
+    (*RhoLoc) = compute( &coeffxp_[2], &coeffyp_[2], &coeffzp_[2], Rho3D, ip_, jp_, kp_);
+
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 4th Order Interpolation of the fields for a batch of particles (same arithmetic as the single particle version)
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator3D4Order::batch(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nparts, double* Epart, double* Bpart, int* iold, double* delta, field_real* tile, int tile_start)
+{
+    int n = iend-istart;
+
+    // Indexes of the central nodes and interpolation coefficients, stored by node for the whole batch
+    double delta_x[batch_size], delta_y[batch_size], delta_z[batch_size];
+    int ip[batch_size], id[batch_size], jp[batch_size], jd[batch_size], kp[batch_size], kd[batch_size];
+    double coeffxp[5*batch_size], coeffxd[5*batch_size];
+    double coeffyp[5*batch_size], coeffyd[5*batch_size];
+    double coeffzp[5*batch_size], coeffzd[5*batch_size];
+
+    double* position_x = &( particles.position(0, 0) );
+    double* position_y = &( particles.position(1, 0) );
+    double* position_z = &( particles.position(2, 0) );
+
+    // Indexes of the central nodes (global), computed apart so that the loops have no inner branch
+    #pragma omp simd
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        double xpn = position_x[istart+ipart]*dx_inv_;
+        double ypn = position_y[istart+ipart]*dy_inv_;
+        double zpn = position_z[istart+ipart]*dz_inv_;
+        ip[ipart] = round(xpn);
+        id[ipart] = round(xpn+0.5);
+        jp[ipart] = round(ypn);
+        jd[ipart] = round(ypn+0.5);
+        kp[ipart] = round(zpn);
+        kd[ipart] = round(zpn+0.5);
+    }
+
+    #pragma omp simd
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        // Normalized particle position
+        double xpn = position_x[istart+ipart]*dx_inv_;
+        double ypn = position_y[istart+ipart]*dy_inv_;
+        double zpn = position_z[istart+ipart]*dz_inv_;
+
+        ShapeFunction::quartic( xpn - (double)id[ipart] + 0.5, &coeffxd[ipart], batch_size );
+        double dx = xpn - (double)ip[ipart];
+        ShapeFunction::quartic( dx, &coeffxp[ipart], batch_size );
+
+        ShapeFunction::quartic( ypn - (double)jd[ipart] + 0.5, &coeffyd[ipart], batch_size );
+        double dy = ypn - (double)jp[ipart];
+        ShapeFunction::quartic( dy, &coeffyp[ipart], batch_size );
+
+        ShapeFunction::quartic( zpn - (double)kd[ipart] + 0.5, &coeffzd[ipart], batch_size );
+        double dz = zpn - (double)kp[ipart];
+        ShapeFunction::quartic( dz, &coeffzp[ipart], batch_size );
+
+        // First index for summation
+        ip[ipart] -= i_domain_begin;
+        id[ipart] -= i_domain_begin;
+        jp[ipart] -= j_domain_begin;
+        jd[ipart] -= j_domain_begin;
+        kp[ipart] -= k_domain_begin;
+        kd[ipart] -= k_domain_begin;
+
+        // Last primal delta, buffered for the projector
+        delta_x[ipart] = dx;
+        delta_y[ipart] = dy;
+        delta_z[ipart] = dz;
+    }
+
+    //Buffering of iol and delta (strided stores, kept out of the loop above so that it vectorizes)
+    for (int ipart=0 ; ipart<n ; ipart++) {
+        iold[ipart*3+0]  = ip[ipart];
+        iold[ipart*3+1]  = jp[ipart];
+        iold[ipart*3+2]  = kp[ipart];
+        delta[ipart*3+0] = delta_x[ipart];
+        delta[ipart*3+1] = delta_y[ipart];
+        delta[ipart*3+2] = delta_z[ipart];
+    }
+
+    // Ex^(d,p,p), Ey^(p,d,p), Ez^(p,p,d), Bx^(p,d,d), By^(d,p,d), Bz^(d,d,p)
+    Field* fields[6] = { EMfields->Ex_, EMfields->Ey_, EMfields->Ez_, EMfields->Bx_m, EMfields->By_m, EMfields->Bz_m };
+    double* res[6]   = { Epart, Epart+nparts, Epart+2*nparts, Bpart, Bpart+nparts, Bpart+2*nparts };
+    double* cx[6]    = { coeffxd, coeffxp, coeffxp, coeffxp, coeffxd, coeffxd };
+    double* cy[6]    = { coeffyp, coeffyd, coeffyp, coeffyd, coeffyp, coeffyd };
+    double* cz[6]    = { coeffzp, coeffzp, coeffzd, coeffzd, coeffzd, coeffzp };
+    int* ix[6]       = { id, ip, ip, ip, id, id };
+    int* iy[6]       = { jp, jd, jp, jd, jp, jd };
+    int* iz[6]       = { kp, kp, kd, kd, kd, kp };
+
+    // In the tile, the six components are interleaved on the dual grid
+    int ny = EMfields->dimDual[1];
+    int nz = EMfields->dimDual[2];
+    for (int c=0 ; c<6 ; c++) {
+        if (tile)
+            gather( cx[c], cy[c], cz[c], tile+c, 6*ny*nz, 6*nz, 6, tile_start, ix[c], iy[c], iz[c], n, res[c] );
+        else
+            gather( cx[c], cy[c], cz[c], fields[c]->data(), fields[c]->dims_[1]*fields[c]->dims_[2], fields[c]->dims_[2], 1, 0, ix[c], iy[c], iz[c], n, res[c] );
+    }
+
+} // END Interpolator3D4Order::batch
+
+void Interpolator3D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
+{
+    double* Epart = smpi->dynamics_Epart[ithread].data();
+    double* Bpart = smpi->dynamics_Bpart[ithread].data();
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
+    int* iold = smpi->dynamics_iold[ithread].data();
+    double* delta = smpi->dynamics_deltaold[ithread].data();
+    int tile_start = smpi->dynamics_EBtile_start[ithread];
+    field_real* tile = tile_start >= 0 ? smpi->dynamics_EBtile[ithread].data() : NULL;
+
+    //Loop on bin particles, by batches
+    for (int ipart=istart ; ipart<iend; ipart+=batch_size ) {
+        int ipart_end = min( ipart+batch_size, iend );
+        batch(EMfields, particles, ipart, ipart_end, nparts, &Epart[ipart-ipart_ref], &Bpart[ipart-ipart_ref],
+              &iold[(ipart-ipart_ref)*3], &delta[(ipart-ipart_ref)*3], tile, tile_start);
+    }
+
+}
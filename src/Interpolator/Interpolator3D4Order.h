@@ -0,0 +1,85 @@
+#ifndef INTERPOLATOR3D4ORDER_H
+#define INTERPOLATOR3D4ORDER_H
+
+
+#include "Interpolator3D.h"
+#include "Field3D.h"
+#include "ShapeFunction.h"
+
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class for 4th order interpolator for 3d3v simulations
+//  --------------------------------------------------------------------------------------------------------------------
+class Interpolator3D4Order : public Interpolator3D
+{
+
+public:
+    Interpolator3D4Order(Params&, Patch*);
+    ~Interpolator3D4Order() override final {};
+
+    //! Interpolate E and B for particle ipart: component i is stored at ELoc[i*nparts] and BLoc[i*nparts]
+
+    inline void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc);
+    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0) override final ;
+    void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc, LocalFields* JLoc, double* RhoLoc) override final ;
+
+    inline double compute( double* coeffx, double* coeffy, double* coeffz, Field3D* f, int idx, int idy, int idz) {
+        double interp_res(0.);
+        for (int iloc=-2 ; iloc<3 ; iloc++) {
+            for (int jloc=-2 ; jloc<3 ; jloc++) {
+                for (int kloc=-2 ; kloc<3 ; kloc++) {
+                    interp_res += *(coeffx+iloc) * *(coeffy+jloc) * *(coeffz+kloc) * (*f)(idx+iloc,idy+jloc,idz+kloc);
+                }
+            }
+        }
+        return interp_res;
+    };
+
+    //! Number of particles interpolated together by the vectorized gather
+    static const int batch_size = 32;
+
+    //! Interpolate E and B for particles istart to iend-1 (at most batch_size particles, buffered from Epart[0]):
+    //! the shape coefficients of the whole batch are computed first, then each component is gathered in a single loop,
+    //! from the patch arrays or from the bin tile if any (tile != NULL, its first row being tile_start)
+    void batch(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nparts, double* Epart, double* Bpart, int* iold, double* delta, field_real* tile, int tile_start);
+
+    //! Gather a field for n particles, coefficients being stored by node (coeffx[iloc*batch_size+ipart]):
+    //! node (i,j,k) is read at data[(i-i0)*sx+j*sy+k*sz]
+    inline void gather( double* coeffx, double* coeffy, double* coeffz, field_real* data, int sx, int sy, int sz, int i0, int* idx, int* idy, int* idz, int n, double* res) {
+        #pragma omp simd
+        for (int ipart=0 ; ipart<n ; ipart++) {
+            double interp_res(0.);
+            for (int iloc=0 ; iloc<5 ; iloc++) {
+                for (int jloc=0 ; jloc<5 ; jloc++) {
+                    for (int kloc=0 ; kloc<5 ; kloc++) {
+                        interp_res += coeffx[iloc*batch_size+ipart] * coeffy[jloc*batch_size+ipart] * coeffz[kloc*batch_size+ipart]
+                            * data[ (idx[ipart]-i0+iloc-2)*sx + (idy[ipart]+jloc-2)*sy + (idz[ipart]+kloc-2)*sz ];
+                    }
+                }
+            }
+            res[ipart] = interp_res;
+        }
+    };
+
+    //! Interpolation of the next bins from the tile of E and B
+    void open_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim) override final {
+        fill_bin_tile(EMfields, smpi, ithread, ibin, clrw, b_dim);
+    };
+
+private:
+
+    // Last prim index computed
+    int ip_, jp_, kp_;
+    // Last dual index computed
+    int id_, jd_, kd_;
+    // Last delta computed
+    double deltax, deltay, deltaz;
+    // Interpolation coefficient on Prim grid
+    double coeffxp_[5], coeffyp_[5], coeffzp_[5];
+    // Interpolation coefficient on Dual grid
+    double coeffxd_[5], coeffyd_[5], coeffzd_[5];
+
+
+};//END class
+
+#endif
@@ -11,11 +11,13 @@ Ionization::Ionization(Params& params, Species * species) {
     nDim_particle        = params.nDim_particle;
     atomic_number_       = species->atomic_number;
     ionized_species_mass = species->mass;
+    random               = &species->random;
     
     // Normalization constant from Smilei normalization to/from atomic units
     eV_to_au = 1.0 / 27.2116;
     EC_to_au = 3.314742578e-15 * referenceAngularFrequency_SI; // hbar omega / (me c^2 alpha^3)
     au_to_w0 = 4.134137172e+16 / referenceAngularFrequency_SI; // alpha^2 me c^2 / (hbar omega)
+    au_to_mec2 = 27.2116/510.998e3; // alpha^2
     
     // Ionization potential & quantum numbers (all in atomic units 1 au = 27.2116 eV)
     Potential.resize(atomic_number_);
@@ -7,7 +7,10 @@
 #include "Params.h"
 #include "Field.h"
 #include "Particles.h"
+#include "Random.h"
 
+class ElectroMagn;
+class Projector;
 
 //! Class Ionization: generic class allowing to define Ionization physics
 class Ionization
@@ -18,11 +21,11 @@ public:
     Ionization(Params& params, Species * species);
     virtual ~Ionization();
     
-    //! Overloading of () operator
-    virtual void operator() (Particles &particles, int ipart, LocalFields Epart) = 0;
-    
-    //! Overloading of () operator
-    virtual void operator() (Particles &particles, int ipart, LocalFields Epart, LocalFields Jion) = 0;
+    //! Ionize the particles ipart_min to ipart_max-1, the electric field at their positions being stored by component
+    //! (Epart[c*nparts+ipart-ipart_ref]): the new electrons are appended to new_electrons and the ionization current
+    //! is projected by Proj
+    virtual void operator() (Particles &particles, int ipart_min, int ipart_max, double* Epart, int nparts,
+                             ElectroMagn* EMfields, Projector* Proj, int ipart_ref = 0) = 0;
     
     Particles new_electrons;
 
@@ -33,6 +36,7 @@ protected:
     double eV_to_au;
     double EC_to_au;
     double au_to_w0;
+    double au_to_mec2;
     
     double referenceAngularFrequency_SI;
     double dt;
@@ -40,6 +44,9 @@ protected:
     unsigned int nDim_particle;
     unsigned int atomic_number_;
     unsigned int ionized_species_mass;
+    
+    //! Random numbers of the ionized species (drawn for each particle, in the stream of the timestep)
+    Random* random;
 
 private:
 
@@ -1,9 +1,12 @@
 #include "IonizationTunnel.h"
 
 #include <cmath>
+#include <limits>
 
 #include "Particles.h"
 #include "Species.h"
+#include "ElectroMagn.h"
+#include "Projector.h"
 
 using namespace std;
 
@@ -26,6 +29,35 @@ IonizationTunnel::IonizationTunnel(Params& params, Species * species) : Ionizati
         gamma_tunnel[Z] = 2.0 * pow(2.0*Potential[Z],1.5);
     }
     
+    // Fields below which the ionization probability rate*dt is below 1e-17 (exp(-rate*dt) is then 1 in double
+    // precision). The rate increases with the field up to E_peak = gamma/(3*alpha), where it is maximum.
+    E2_min.resize(atomic_number_);
+    double log_rate_min = log( 1.e-17 / dt );
+    for (unsigned int Z=0 ; Z<atomic_number_ ; Z++) {
+        double E_peak = alpha_tunnel[Z]>0. ? gamma_tunnel[Z]/(3.*alpha_tunnel[Z]) : 1.e3*gamma_tunnel[Z];
+        if ( log(rate(Z, E_peak)) < log_rate_min ) { // never ionized
+            E2_min[Z] = numeric_limits<double>::max();
+            continue;
+        }
+        // log(rate) = log(beta) + alpha*log(gamma/E) - gamma/(3E) (the logarithm avoids underflows)
+        double E_low = E_peak, E_high = E_peak;
+        do {
+            E_high = E_low;
+            E_low *= 0.5;
+        } while ( log(beta_tunnel[Z]) + alpha_tunnel[Z]*log(gamma_tunnel[Z]/E_low) - gamma_tunnel[Z]*one_third/E_low >= log_rate_min );
+        for (int i=0; i<60; i++) {
+            double E_mid = 0.5*(E_low+E_high);
+            if ( log(beta_tunnel[Z]) + alpha_tunnel[Z]*log(gamma_tunnel[Z]/E_mid) - gamma_tunnel[Z]*one_third/E_mid < log_rate_min )
+                E_low = E_mid;
+            else
+                E_high = E_mid;
+        }
+        E2_min[Z] = pow( E_low/EC_to_au, 2 );
+    }
+    
+    IonizRate_tunnel.resize(atomic_number_);
+    Dnom_tunnel.resize(atomic_number_);
+    
     new_electrons.initialize(0, params.nDim_particle );
     DEBUG("Finished Creating the Tunnel Ionizaton class");
 
@@ -33,139 +65,57 @@ IonizationTunnel::IonizationTunnel(Params& params, Species * species) : Ionizati
 
 
 
-void IonizationTunnel::operator() (Particles &particles, int ipart, LocalFields Epart) {
-    for (unsigned int i=0; i< particles.size(); i++) {
-        particles.print(i);
+void IonizationTunnel::operator() (Particles &particles, int ipart_min, int ipart_max, double* Epart, int nparts,
+                                   ElectroMagn* EMfields, Projector* Proj, int ipart_ref) {
+    
+    double* Ex = &Epart[0*nparts];
+    double* Ey = &Epart[1*nparts];
+    double* Ez = &Epart[2*nparts];
+    
+    // Select the ions which may be ionized: most of them are in a field too weak to ionize them
+    // ----------------------------------------------------------------------------------------
+    candidates.resize(0);
+    for (int ipart=ipart_min ; ipart<ipart_max ; ipart++) {
+        unsigned int Z = (unsigned int)(particles.charge(ipart));
+        if (Z >= atomic_number_) continue;
+        int i = ipart-ipart_ref;
+        double E2 = Ex[i]*Ex[i] + Ey[i]*Ey[i] + Ez[i]*Ez[i];
+        if (E2 > E2_min[Z]) candidates.push_back(ipart);
     }
+    unsigned int ncandidates = candidates.size();
+    if (ncandidates == 0) return;
     
-    // Charge state of the ion (particle)
-    unsigned int Z = (unsigned int)(particles.charge(ipart));
-    
-    // Number of successive ionization in one time-step
-    unsigned int k_times = 0;
-    
-    // Generate a random number between 0 and 1
-    double ran_p = (double)rand() / RAND_MAX;
-    
-    // Absolute value of the electric field normalized in atomic units
-    double E = EC_to_au * sqrt( Epart.x*Epart.x + Epart.y*Epart.y + Epart.z*Epart.z );
-    
-    // Ionization rate in normalized (SMILEI) units
-    double delta = gamma_tunnel[Z] / E;
-    vector<double> IonizRate_tunnel(atomic_number_);
-    IonizRate_tunnel[Z] = beta_tunnel[Z] * pow(delta,alpha_tunnel[Z]) * exp(-delta*one_third);
+    // Generate the random numbers between 0 and 1 (each one depends only on the index of the ion)
+    ran_p.resize(ncandidates);
+    for (unsigned int c=0 ; c<ncandidates ; c++)
+        ran_p[c] = random->uniform( candidates[c], 0 );
     
     // --------------------------------
     // Start of the Monte-Carlo routine
     // --------------------------------
-    if (E!=0 && Z!=atomic_number_) {
+    k_times.resize(ncandidates);
+    unsigned int n_new = 0;
+    for (unsigned int c=0 ; c<ncandidates ; c++) {
+        int ipart = candidates[c];
+        int i = ipart-ipart_ref;
         
-        // if ionization of the last electron: single ionization
-        // -----------------------------------------------------
-        if ( Z == atomic_number_-1) {
-            if ( ran_p < 1.0 -exp(-IonizRate_tunnel[Z]*dt) ) {
-                k_times = 1;
-            }
-            
-            // else : multiple ionization can occur in one time-step
-            //        partial & final ionization are decoupled (see Nuter Phys. Plasmas)
-            // -------------------------------------------------------------------------
-        } else {
-            // initialization
-            double Mult = 1.0;
-            vector<double> Dnom_tunnel(atomic_number_);
-            Dnom_tunnel[0]=1.0;
-            double Pint_tunnel = exp(-IonizRate_tunnel[Z]*dt); // cummulative prob.
-            
-            //multiple ionization loop while Pint_tunnel < ran_p and still partial ionization
-            while ((Pint_tunnel < ran_p) and (k_times < atomic_number_-Z-1)) {
-                unsigned int newZ = Z+k_times+1;
-                double Prob  = 0.0;
-                delta = gamma_tunnel[newZ] / E;
-                IonizRate_tunnel[newZ] = beta_tunnel[newZ]
-                                         *                        pow(delta,alpha_tunnel[newZ])
-                                         *                        exp(-delta*one_third);
-                double D_sum = 0.0;
-                double P_sum = 0.0;
-                Mult  *= IonizRate_tunnel[Z+k_times];
-                for (unsigned int i=0; i<k_times+1; i++) {
-                    Dnom_tunnel[i]=Dnom_tunnel[i]/(IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+i]);
-                    D_sum += Dnom_tunnel[i];
-                    P_sum += exp(-IonizRate_tunnel[Z+i]*dt)*Dnom_tunnel[i];
-                }
-                Dnom_tunnel[k_times+1] = -D_sum;
-                P_sum                  = P_sum + Dnom_tunnel[k_times+1]*exp(-IonizRate_tunnel[newZ]*dt);
-                Prob                   = P_sum * Mult;
-                Pint_tunnel            = Pint_tunnel+Prob;
-                
-                k_times++;
-            }//END while
-            
-            // final ionization
-            if ( ((1.0-Pint_tunnel)>ran_p) && (k_times==atomic_number_-Z-1) ) {
-                k_times++;
-            }
-        }//END Multiple ionization routine
+        // Charge state of the ion (particle)
+        unsigned int Z = (unsigned int)(particles.charge(ipart));
         
+        // Number of successive ionization in one time-step
+        unsigned int k = 0;
         
-        // Creation of the new electrons
-        // (variable weights are used)
-        // -----------------------------
-        if (k_times !=0) {
-            new_electrons.create_particle();
-            //new_electrons.initialize( new_electrons.size()+1, new_electrons.dimension() );
-            int idNew = new_electrons.size() - 1;
-            for (unsigned int i=0; i<new_electrons.dimension(); i++) {
-                new_electrons.position(i,idNew)=particles.position(i, ipart);
-            }
-            for (unsigned int i=0; i<3; i++) {
-                new_electrons.momentum(i,idNew) = particles.momentum(i, ipart)/ionized_species_mass;
-            }
-            new_electrons.weight(idNew)=double(k_times)*particles.weight(ipart);
-            new_electrons.charge(idNew)=-1;
-            
-            // Increase the charge of the particle
-            particles.charge(ipart) += k_times;
-        }
+        // Absolute value of the electric field normalized in atomic units
+        double E = EC_to_au * sqrt( Ex[i]*Ex[i] + Ey[i]*Ey[i] + Ez[i]*Ez[i] );
+        
+        // Ionization rate in normalized (SMILEI) units
+        IonizRate_tunnel[Z] = rate(Z, E);
         
-    }//END test on electric field && Z_atomic
-
-}
-
-
-
-void IonizationTunnel::operator() (Particles &particles, int ipart, LocalFields Epart, LocalFields Jion) {
-    
-    // Total ionization potential (used to compute the ionization current)
-    double TotalIonizPot = 0.0;
-    
-    // Charge state of the ion (particle)
-    unsigned int Z = (unsigned int)(particles.charge(ipart));
-    
-    // Number of successive ionization in one time-step
-    unsigned int k_times = 0;
-    
-    // Generate a random number between 0 and 1
-    double ran_p = (double)rand() / RAND_MAX;
-    
-    // Absolute value of the electric field normalized in atomic units
-    double E = EC_to_au * sqrt( Epart.x*Epart.x + Epart.y*Epart.y + Epart.z*Epart.z );
-    
-    // Ionization rate in normalized (SMILEI) units
-    double delta     = gamma_tunnel[Z] / E;
-    vector<double> IonizRate_tunnel(atomic_number_);
-    IonizRate_tunnel[Z] = beta_tunnel[Z] * pow(delta,alpha_tunnel[Z]) * exp(-delta*one_third);
-    
-    // --------------------------------
-    // Start of the Monte-Carlo routine
-    // --------------------------------
-    if (E!=0 && Z!=atomic_number_) {
-    
         if ( Z == atomic_number_-1) {
             // if ionization of the last electron: single ionization
             // -----------------------------------------------------
-            if ( ran_p < 1.0 -exp(-IonizRate_tunnel[Z]*dt) ) {
-                k_times        = 1;
+            if ( ran_p[c] < 1.0 -exp(-IonizRate_tunnel[Z]*dt) ) {
+                k = 1;
             }
             
         } else {
@@ -175,73 +125,78 @@ void IonizationTunnel::operator() (Particles &particles, int ipart, LocalFields
             
             // initialization
             double Mult = 1.0;
-            vector<double> Dnom_tunnel(atomic_number_);
             Dnom_tunnel[0]=1.0;
             double Pint_tunnel = exp(-IonizRate_tunnel[Z]*dt); // cummulative prob.
             
             //multiple ionization loop while Pint_tunnel < ran_p and still partial ionization
-            while ((Pint_tunnel < ran_p) and (k_times < atomic_number_-Z-1)) {
-                unsigned int newZ = Z+k_times+1;
+            while ((Pint_tunnel < ran_p[c]) and (k < atomic_number_-Z-1)) {
+                unsigned int newZ = Z+k+1;
                 double Prob  = 0.0;
-                delta = gamma_tunnel[newZ] / E;
-                IonizRate_tunnel[newZ] = beta_tunnel[newZ]
-                *                        pow(delta,alpha_tunnel[newZ])
-                *                        exp(-delta*one_third);
+                IonizRate_tunnel[newZ] = rate(newZ, E);
                 double D_sum = 0.0;
                 double P_sum = 0.0;
-                Mult  *= IonizRate_tunnel[Z+k_times];
-                for (unsigned int i=0; i<k_times+1; i++) {
-                    Dnom_tunnel[i]=Dnom_tunnel[i]/(IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+i]);
-                    D_sum += Dnom_tunnel[i];
-                    P_sum += exp(-IonizRate_tunnel[Z+i]*dt)*Dnom_tunnel[i];
+                Mult  *= IonizRate_tunnel[Z+k];
+                for (unsigned int j=0; j<k+1; j++) {
+                    Dnom_tunnel[j]=Dnom_tunnel[j]/(IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+j]);
+                    D_sum += Dnom_tunnel[j];
+                    P_sum += exp(-IonizRate_tunnel[Z+j]*dt)*Dnom_tunnel[j];
                 }
-                Dnom_tunnel[k_times+1] = -D_sum;
-                P_sum                  = P_sum + Dnom_tunnel[k_times+1]*exp(-IonizRate_tunnel[newZ]*dt);
-                Prob                   = P_sum * Mult;
-                Pint_tunnel            = Pint_tunnel+Prob;
+                Dnom_tunnel[k+1] = -D_sum;
+                P_sum            = P_sum + Dnom_tunnel[k+1]*exp(-IonizRate_tunnel[newZ]*dt);
+                Prob             = P_sum * Mult;
+                Pint_tunnel      = Pint_tunnel+Prob;
                 
-                k_times++;
+                k++;
             }//END while
             
             // final ionization (of last electron)
-            if ( ((1.0-Pint_tunnel)>ran_p) && (k_times==atomic_number_-Z-1) ) {
-                k_times++;
+            if ( ((1.0-Pint_tunnel)>ran_p[c]) && (k==atomic_number_-Z-1) ) {
+                k++;
             }
         }//END Multiple ionization routine
         
+        k_times[c] = k;
+        if (k != 0) n_new++;
+    }
+    if (n_new == 0) return;
+    
+    // Creation of the new electrons (variable weights are used)
+    // and projection of the ionization current, in a single pass
+    // -----------------------------------------------------------
+    unsigned int idNew = new_electrons.size();
+    new_electrons.create_particles( n_new );
+    LocalFields Jion;
+    for (unsigned int c=0 ; c<ncandidates ; c++) {
+        if (k_times[c] == 0) continue;
+        int ipart = candidates[c];
+        int i = ipart-ipart_ref;
+        unsigned int Z = (unsigned int)(particles.charge(ipart));
         
-        // Calculation of the ionization current
-        // -------------------------------------
-        for (unsigned int k=0; k<k_times; k++) {
-            TotalIonizPot += Potential[Z+k];
-        }//END for k
-        
-        double factorJion = TotalIonizPot/dt/E/E;
-        Jion.x = factorJion * Epart.x;
-        Jion.y = factorJion * Epart.y;
-        Jion.z = factorJion * Epart.z;
-        
+        for (unsigned int j=0; j<new_electrons.dimension(); j++) {
+            new_electrons.position(j,idNew)=particles.position(j, ipart);
+        }
+        for (unsigned int j=0; j<3; j++) {
+            new_electrons.momentum(j,idNew) = particles.momentum(j, ipart)/ionized_species_mass;
+        }
+        new_electrons.weight(idNew)=double(k_times[c])*particles.weight(ipart);
+        new_electrons.charge(idNew)=-1;
+        idNew++;
         
-        // Creation of the new electrons
-        // (variable weights are used)
-        // -----------------------------
-        if (k_times !=0) {
-            new_electrons.create_particle();
-            //new_electrons.initialize( new_electrons.size()+1, new_electrons.dimension() );
-            int idNew = new_electrons.size() - 1;
-            for (unsigned int i=0; i<new_electrons.dimension(); i++) {
-                new_electrons.position(i,idNew)=particles.position(i, ipart);
-            }
-            for (unsigned int i=0; i<3; i++) {
-                new_electrons.momentum(i,idNew) = particles.momentum(i, ipart)/ionized_species_mass;
-            }
-            new_electrons.weight(idNew)=double(k_times)*particles.weight(ipart);
-            new_electrons.charge(idNew)=-1;
-            
-            // Increase the charge of the particle
-            particles.charge(ipart) += k_times;
+        // Ionization current, such that J.E dt is the ionization energy (the weight is applied by the projector)
+        if (!particles.isTest) {
+            double TotalIonizPot = 0.0;
+            for (unsigned int k=0; k<k_times[c]; k++) {
+                TotalIonizPot += Potential[Z+k];
+            }//END for k
+            double factorJion = au_to_mec2 * TotalIonizPot / dt / ( Ex[i]*Ex[i] + Ey[i]*Ey[i] + Ez[i]*Ez[i] );
+            Jion.x = factorJion * Ex[i];
+            Jion.y = factorJion * Ey[i];
+            Jion.z = factorJion * Ez[i];
+            (*Proj)(EMfields->Jx_, EMfields->Jy_, EMfields->Jz_, particles, ipart, Jion);
         }
         
-    }//END test on electric field && Z_atomic
+        // Increase the charge of the particle
+        particles.charge(ipart) += k_times[c];
+    }
 
 }
@@ -18,18 +18,34 @@ public:
     //! Constructor for IonizationTunnel: with no input argument
     IonizationTunnel(Params& params, Species * species);
     
-    //! apply the Tunnel Ionization model to the species (without ionization current)
-    virtual void operator() (Particles &particles, int ipart, LocalFields Epart);
-    
-    //! apply the Tunnel Ionization model to the species (with ionization current)
-    virtual void operator() (Particles &particles, int ipart, LocalFields Epart, LocalFields Jion);
+    //! apply the Tunnel Ionization model to the particles ipart_min to ipart_max-1 (with ionization current)
+    void operator() (Particles &particles, int ipart_min, int ipart_max, double* Epart, int nparts,
+                     ElectroMagn* EMfields, Projector* Proj, int ipart_ref = 0) override;
     
     double one_third;
     std::vector<double> alpha_tunnel;
     std::vector<double> beta_tunnel;
     std::vector<double> gamma_tunnel;
+    
+    //! Square of the field (normalized units) below which the ionization probability of each charge state during
+    //! a timestep is too small to be resolved (exp(-rate*dt) rounds to 1): the ions in weaker fields are skipped
+    std::vector<double> E2_min;
 
 private:
+    //! Ionization rate of charge state Z in the field E (atomic units)
+    inline double rate( unsigned int Z, double E ) {
+        double delta = gamma_tunnel[Z] / E;
+        return beta_tunnel[Z] * pow(delta,alpha_tunnel[Z]) * exp(-delta*one_third);
+    }
+    
+    //! Ions which may be ionized in the current block, and their random numbers and numbers of ionizations
+    std::vector<int> candidates;
+    std::vector<double> ran_p;
+    std::vector<unsigned int> k_times;
+    
+    //! Temporary arrays of the multiple ionization
+    std::vector<double> IonizRate_tunnel;
+    std::vector<double> Dnom_tunnel;
 };
 
 
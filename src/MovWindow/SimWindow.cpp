@@ -66,7 +66,7 @@ void SimWindow::operate(VectorPatch& vecPatches, SmileiMPI* smpi, Params& params
     int nSpecies  ( vecPatches(0)->vecSpecies.size() );
     //int nmessage = 14+2*nSpecies;
     int nmax_laser = 4;
-    int nmessage = 2*nSpecies+(2+params.nDim_particle)*vecPatches(0)->probes.size()+
+    int nmessage = 2*nSpecies+vecPatches(0)->vecCollisions.size()+(2+params.nDim_particle)*vecPatches(0)->probes.size()+
         9+vecPatches(0)->EMfields->antennas.size()+4*nmax_laser;
     
     double energy_field_lost(0.);
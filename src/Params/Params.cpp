@@ -127,11 +127,13 @@ namelist("")
     }
     
     // random seed
-    unsigned int random_seed=0;
+    random_seed=0;
     if (!PyTools::extract("random_seed", random_seed, "Main")) {
-        random_seed = time(NULL);
+        // The clock of the master only: all the processes must share the same key
+        int clock_seed = time(NULL);
+        smpi->bcast( clock_seed );
+        random_seed = clock_seed;
     }
-    srand(random_seed);
     
     // --------------
     // Stop & Restart
@@ -171,7 +173,7 @@ namelist("")
     if (interpolation_order!=2 && interpolation_order!=4) {
         ERROR("Main.interpolation_order " << interpolation_order << " not defined");
     }
-    if ( (geometry=="2d3v" || geometry=="3d3v") && interpolation_order==4) {
+    if ( geometry=="2d3v" && interpolation_order==4) {
         ERROR("Main.interpolation_order = 4 " << interpolation_order << " not yet available in 2D");
     }
     
@@ -252,6 +254,13 @@ namelist("")
     // Maxwell Solver 
     PyTools::extract("maxwell_sol", maxwell_sol, "Main");
     
+    // Time blocking of the Maxwell solver (the oversize grows by one cell per timestep without exchange)
+    PyTools::extract("exchange_fields_each", exchange_fields_each, "Main");
+    if (exchange_fields_each<1)
+        ERROR("Main.exchange_fields_each must be at least 1");
+    if (exchange_fields_each>1 && maxwell_sol!="Yee")
+        ERROR("Main.exchange_fields_each > 1 is only available with the Yee solver");
+    
     // Filtering Method Parameters
     PyTools::extract("currentFilter_int", currentFilter_int, "Main"); // nb of passes for binomial filering (default=0)
     
@@ -383,7 +392,7 @@ void Params::compute()
 
     //n_space_global.resize(nDim_field, 0);
     for (unsigned int i=0; i<nDim_field; i++){
-        oversize[i]  = interpolation_order + (exchange_particles_each-1);;
+        oversize[i]  = interpolation_order + (exchange_particles_each-1) + (exchange_fields_each-1);
         n_space_global[i] = n_space[i];
         n_space[i] /= number_of_patches[i];
         if(n_space_global[i]%number_of_patches[i] !=0) ERROR("ERROR in dimension " << i <<". Number of patches = " << number_of_patches[i] << " must divide n_space_global = " << n_space_global[i]);
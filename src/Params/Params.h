@@ -120,6 +120,9 @@ public:
     //! dt for the simulation
     double timestep;
     
+    //! Seed of the random number generators (see Random)
+    unsigned int random_seed;
+    
     //! max value for dt (due to usual FDTD CFL condition: should be moved to ElectroMagn solver (MG))
     double dtCFL;
     
@@ -149,6 +152,10 @@ public:
     //! frequency of exchange particles (default = 1, disabled for now, incompatible with sort) 
     int exchange_particles_each;
     
+    //! frequency of exchange of E and B between patches (default = 1): the field solver advances
+    //! exchange_fields_each timesteps between exchanges in guard cells exchange_fields_each-1 cells wider
+    int exchange_fields_each;
+    
     //! Total number of patches
     int tot_number_of_patches;
     //! Number of patches per direction
@@ -133,6 +133,7 @@ void Patch::finishCreation( Params& params, SmileiMPI* smpi ) {
     
     // interpolation operator (virtual)
     Interp     = InterpolatorFactory::create(params, this); // + patchId -> idx_domain_begin (now = ref smpi)
+    createThreadInterpolators(params);
     // projection operator (virtual)
     Proj       = ProjectorFactory::create(params, this);    // + patchId -> idx_domain_begin (now = ref smpi)
     
@@ -159,6 +160,7 @@ void Patch::finishCloning( Patch* patch, Params& params, SmileiMPI* smpi, bool w
     
     // interpolation operator (virtual)
     Interp     = InterpolatorFactory::create(params, this);
+    createThreadInterpolators(params);
     // projection operator (virtual)
     Proj       = ProjectorFactory::create(params, this);
     
@@ -176,6 +178,20 @@ void Patch::finishCloning( Patch* patch, Params& params, SmileiMPI* smpi, bool w
 }
 
 
+// The interpolators store the coefficients of the current particle: the threads sharing the bins of a species
+// need one each. They are created once with the patch, only if a species may share its bins (split_patch_threshold)
+void Patch::createThreadInterpolators( Params& params ) {
+    for (unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++) {
+        if (vecSpecies[ispec]->split_patch_threshold > 0) {
+            thread_Interp.resize( omp_get_max_threads() );
+            for (unsigned int ithread=0 ; ithread<thread_Interp.size() ; ithread++)
+                thread_Interp[ithread] = InterpolatorFactory::create(params, this);
+            return;
+        }
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Delete Patch members
 // ---------------------------------------------------------------------------------------------------------------------
@@ -189,6 +205,8 @@ Patch::~Patch() {
     delete partWalls;
     delete Proj;
     delete Interp;
+    for (unsigned int ithread=0 ; ithread<thread_Interp.size() ; ithread++) delete thread_Interp[ithread];
+    thread_Interp.clear();
     
     delete EMfields;
     for (unsigned int ispec=0 ; ispec<vecSpecies.size(); ispec++) delete vecSpecies[ispec];
@@ -541,6 +559,7 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
         for (unsigned int j=1; j<(*cubmax).size()+1;j++){ //bin 0 is not shifted.Last element of shift stores total number of arriving particles.
             shift[j]+=shift[j-1];
         }
+        vecSpecies[ispec]->addUnsortedParticles( shift[(*cubmax).size()] );
         //Make room for new particles
         if (shift[(*cubmax).size()]) {
           //! vecor::resize of Charge crashed ! Temporay solution : push_back / Particle
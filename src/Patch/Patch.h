@@ -43,6 +43,8 @@ public:
     void finishCreation( Params& params, SmileiMPI* smpi );
     //! Last cloning step
     void finishCloning( Patch* patch, Params& params, SmileiMPI* smpi, bool with_particles );
+    //! Create the interpolators of the threads (thread_Interp) if a species may share its bins among them
+    void createThreadInterpolators( Params& params );
     
     //! Destructor for Patch
     virtual ~Patch();
@@ -62,6 +64,8 @@ public:
     
     //! Interpolator (used to push particles and for probes)
     Interpolator* Interp;
+    //! Interpolators of the threads sharing the bins of a species (see Species::dynamics_shared), one per thread
+    std::vector<Interpolator*> thread_Interp;
     //! Projector
     Projector* Proj;
     
@@ -80,7 +80,7 @@ void Patch1D::reallyinitSumField( Field* field, int iDim )
 void Patch1D::initSumField( Field* field, int iDim )
 {
     if (field->MPIbuff.srequest.size()==0){
-        field->MPIbuff.allocate(1, field);
+        field->MPIbuff.allocate(1, field, oversize);
 
         int tagp(0);
         if (field->name == "Jx") tagp = 1;
@@ -120,7 +120,7 @@ void Patch1D::initSumField( Field* field, int iDim )
         if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
             int tmp_elem = f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
             int tag = f1D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &( f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+            MPI_Irecv( &( f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_FIELD_REAL, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
         } // END of Recv
             
     } // END for iNeighbor
@@ -269,6 +269,10 @@ void Patch1D::initExchange( Field* field, int iDim )
         if (field->name == "By") tagp = 7;
         if (field->name == "Bz") tagp = 8;
 
+        if (field->name == "Ex") tagp = 6;
+        if (field->name == "Ey") tagp = 7;
+        if (field->name == "Ez") tagp = 8;
+
         field->MPIbuff.defineTags( this, tagp );
     }
 
@@ -342,17 +346,17 @@ void Patch1D::createType( Params& params )
 
         // Standard Type
         ntype_[0][ix_isPrim] = MPI_DATATYPE_NULL;
-        MPI_Type_contiguous(ny, MPI_DOUBLE, &(ntype_[0][ix_isPrim]));    //line
+        MPI_Type_contiguous(ny, MPI_FIELD_REAL, &(ntype_[0][ix_isPrim]));    //line
         MPI_Type_commit( &(ntype_[0][ix_isPrim]) );
 
         ntype_[1][ix_isPrim] = MPI_DATATYPE_NULL;
-        MPI_Type_contiguous(clrw, MPI_DOUBLE, &(ntype_[1][ix_isPrim]));   //clrw lines
+        MPI_Type_contiguous(clrw, MPI_FIELD_REAL, &(ntype_[1][ix_isPrim]));   //clrw lines
         MPI_Type_commit( &(ntype_[1][ix_isPrim]) );
 
         ntypeSum_[0][ix_isPrim] = MPI_DATATYPE_NULL;
 
         MPI_Datatype tmpType = MPI_DATATYPE_NULL;
-        MPI_Type_contiguous(1, MPI_DOUBLE, &(tmpType));    //line
+        MPI_Type_contiguous(1, MPI_FIELD_REAL, &(tmpType));    //line
         MPI_Type_commit( &(tmpType) );
 
 
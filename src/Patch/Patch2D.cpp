@@ -109,7 +109,7 @@ void Patch2D::reallyinitSumField( Field* field, int iDim )
 void Patch2D::initSumField( Field* field, int iDim )
 {
     if (field->MPIbuff.srequest.size()==0) {
-        field->MPIbuff.allocate(2, field);
+        field->MPIbuff.allocate(2, field, oversize);
 
         int tagp(0);
         if (field->name == "Jx") tagp = 1;
@@ -164,7 +164,7 @@ void Patch2D::initSumField( Field* field, int iDim )
             int tag = f2D->MPIbuff.recv_tags_[iDim][iNeighbor];
             //cout << hindex << " recv from " << neighbor_[iDim][(iNeighbor+1)%2] << " ; n_elements = " << tmp_elem << endl;
             //MPI_Irecv( &( (buf[iDim][(iNeighbor+1)%2]).data_2D[0][0] ), tmp_elem, MPI_DOUBLE, 0, tag, MPI_COMM_SELF, &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
-            MPI_Irecv( &( f2D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+            MPI_Irecv( &( f2D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_FIELD_REAL, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
 
         } // END of Recv
             
@@ -435,15 +435,15 @@ void Patch2D::createType( Params& params )
             
             // Standard Type
             ntype_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-            MPI_Type_contiguous(params.oversize[0]*ny, MPI_DOUBLE, &(ntype_[0][ix_isPrim][iy_isPrim]));    //line
+            MPI_Type_contiguous(params.oversize[0]*ny, MPI_FIELD_REAL, &(ntype_[0][ix_isPrim][iy_isPrim]));    //line
             MPI_Type_commit( &(ntype_[0][ix_isPrim][iy_isPrim]) );
             ntype_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-            MPI_Type_vector(nx, params.oversize[1], ny, MPI_DOUBLE, &(ntype_[1][ix_isPrim][iy_isPrim])); // column
+            MPI_Type_vector(nx, params.oversize[1], ny, MPI_FIELD_REAL, &(ntype_[1][ix_isPrim][iy_isPrim])); // column
             MPI_Type_commit( &(ntype_[1][ix_isPrim][iy_isPrim]) );
             
             // Still used ???
             ntype_[2][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
-            MPI_Type_contiguous(ny*clrw, MPI_DOUBLE, &(ntype_[2][ix_isPrim][iy_isPrim]));   //clrw lines
+            MPI_Type_contiguous(ny*clrw, MPI_FIELD_REAL, &(ntype_[2][ix_isPrim][iy_isPrim]));   //clrw lines
             MPI_Type_commit( &(ntype_[2][ix_isPrim][iy_isPrim]) );
             
             ntypeSum_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
@@ -451,7 +451,7 @@ void Patch2D::createType( Params& params )
             //MPI_Type_contiguous(nline, ntype_[0][ix_isPrim][iy_isPrim], &(ntypeSum_[0][ix_isPrim][iy_isPrim]));    //line
             
             MPI_Datatype tmpType = MPI_DATATYPE_NULL;
-            MPI_Type_contiguous(ny, MPI_DOUBLE, &(tmpType));    //line
+            MPI_Type_contiguous(ny, MPI_FIELD_REAL, &(tmpType));    //line
             MPI_Type_commit( &(tmpType) );
             
             MPI_Type_contiguous(nline, tmpType, &(ntypeSum_[0][ix_isPrim][iy_isPrim]));    //line
@@ -461,7 +461,7 @@ void Patch2D::createType( Params& params )
             
             ntypeSum_[1][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
             ncol  = 1 + 2*params.oversize[1] + iy_isPrim;
-            MPI_Type_vector(nx, ncol, ny, MPI_DOUBLE, &(ntypeSum_[1][ix_isPrim][iy_isPrim])); // column
+            MPI_Type_vector(nx, ncol, ny, MPI_FIELD_REAL, &(ntypeSum_[1][ix_isPrim][iy_isPrim])); // column
             MPI_Type_commit( &(ntypeSum_[1][ix_isPrim][iy_isPrim]) );
             
         }
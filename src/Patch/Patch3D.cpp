@@ -126,7 +126,7 @@ void Patch3D::reallyinitSumField( Field* field, int iDim )
 void Patch3D::initSumField( Field* field, int iDim )
 {
     if (field->MPIbuff.srequest.size()==0) {
-        field->MPIbuff.allocate(3, field);
+        field->MPIbuff.allocate(3, field, oversize);
 
         int tagp(0);
         if (field->name == "Jx") tagp = 1;
@@ -186,7 +186,7 @@ void Patch3D::initSumField( Field* field, int iDim )
         if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
             int tmp_elem = f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
             int tag = f3D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &( f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0] ), tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, 
+            MPI_Irecv( &( f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0] ), tmp_elem, MPI_FIELD_REAL, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, 
                        MPI_COMM_WORLD, &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
         } // END of Recv
             
@@ -376,6 +376,10 @@ void Patch3D::initExchange( Field* field, int iDim )
         if (field->name == "By") tagp = 7;
         if (field->name == "Bz") tagp = 8;
 
+        if (field->name == "Ex") tagp = 6;
+        if (field->name == "Ey") tagp = 7;
+        if (field->name == "Ez") tagp = 8;
+
         field->MPIbuff.defineTags( this, tagp );
     }
 
@@ -472,17 +476,17 @@ void Patch3D::createType( Params& params )
                 // Standard Type
                 ntype_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
                 MPI_Type_contiguous(params.oversize[0]*ny*nz, 
-                                    MPI_DOUBLE, &(ntype_[0][ix_isPrim][iy_isPrim][iz_isPrim]));
+                                    MPI_FIELD_REAL, &(ntype_[0][ix_isPrim][iy_isPrim][iz_isPrim]));
                 MPI_Type_commit( &(ntype_[0][ix_isPrim][iy_isPrim][iz_isPrim]) );
 
                 ntype_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
                 MPI_Type_vector(nx, params.oversize[1]*nz, ny*nz, 
-                                MPI_DOUBLE, &(ntype_[1][ix_isPrim][iy_isPrim][iz_isPrim]));
+                                MPI_FIELD_REAL, &(ntype_[1][ix_isPrim][iy_isPrim][iz_isPrim]));
                 MPI_Type_commit( &(ntype_[1][ix_isPrim][iy_isPrim][iz_isPrim]) );
 
                 ntype_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
                 MPI_Type_vector(nx*ny, params.oversize[2], nz, 
-                                MPI_DOUBLE, &(ntype_[2][ix_isPrim][iy_isPrim][iz_isPrim]));
+                                MPI_FIELD_REAL, &(ntype_[2][ix_isPrim][iy_isPrim][iz_isPrim]));
                 MPI_Type_commit( &(ntype_[2][ix_isPrim][iy_isPrim][iz_isPrim]) );
             
 
@@ -492,17 +496,17 @@ void Patch3D::createType( Params& params )
 
                 ntypeSum_[0][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
                 MPI_Type_contiguous(nx_sum*ny*nz, 
-                                    MPI_DOUBLE, &(ntypeSum_[0][ix_isPrim][iy_isPrim][iz_isPrim]));
+                                    MPI_FIELD_REAL, &(ntypeSum_[0][ix_isPrim][iy_isPrim][iz_isPrim]));
                 MPI_Type_commit( &(ntypeSum_[0][ix_isPrim][iy_isPrim][iz_isPrim]) );
             
                 ntypeSum_[1][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
                 MPI_Type_vector(nx, ny_sum*nz, ny*nz, 
-                                MPI_DOUBLE, &(ntypeSum_[1][ix_isPrim][iy_isPrim][iz_isPrim]));
+                                MPI_FIELD_REAL, &(ntypeSum_[1][ix_isPrim][iy_isPrim][iz_isPrim]));
                 MPI_Type_commit( &(ntypeSum_[1][ix_isPrim][iy_isPrim][iz_isPrim]) );
 
                 ntypeSum_[2][ix_isPrim][iy_isPrim][iz_isPrim] = MPI_DATATYPE_NULL;
                 MPI_Type_vector(nx*ny, nz_sum, nz, 
-                                MPI_DOUBLE, &(ntypeSum_[2][ix_isPrim][iy_isPrim][iz_isPrim]));
+                                MPI_FIELD_REAL, &(ntypeSum_[2][ix_isPrim][iy_isPrim][iz_isPrim]));
                 MPI_Type_commit( &(ntypeSum_[2][ix_isPrim][iy_isPrim][iz_isPrim]) );
             
             }
@@ -74,7 +74,7 @@ void SyncVectorPatch::finalize_and_sort_parts(VectorPatch& vecPatches, int ispec
 
     #pragma omp for schedule(runtime)
     for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
-        vecPatches(ipatch)->vecSpecies[ispec]->sort_part();
+        vecPatches(ipatch)->vecSpecies[ispec]->sort_particles();
 }
 
 
@@ -135,6 +135,36 @@ void SyncVectorPatch::exchangeJ( VectorPatch& vecPatches )
     SyncVectorPatch::exchange( vecPatches.listJz_, vecPatches );
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Exchange all the components of E and B in all the ghost cells. The exchanges in a direction are completed before
+// those of the next direction, which copy the ghost cells of the previous ones: the corners are updated as well.
+// Required when the field solver advances several timesteps between two exchanges (exchange_fields_each>1), as the
+// components not exchanged by exchangeB are then wrong in the outer guard cells.
+// E and B share their MPI tags: they are not exchanged at the same time.
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::exchangeEB( VectorPatch& vecPatches )
+{
+    std::vector<Field*>* lists[6] = { &vecPatches.listBx_, &vecPatches.listBy_, &vecPatches.listBz_,
+                                      &vecPatches.listEx_, &vecPatches.listEy_, &vecPatches.listEz_ };
+    unsigned int nDim = vecPatches.listEx_[0]->dims_.size();
+
+    for (unsigned int iDim=0 ; iDim<nDim ; iDim++) {
+        for (unsigned int ifirst=0 ; ifirst<6 ; ifirst+=3) {
+            for (unsigned int i=ifirst ; i<ifirst+3 ; i++) {
+                if      (iDim==0) SyncVectorPatch::exchange0( *lists[i], vecPatches );
+                else if (iDim==1) SyncVectorPatch::exchange1( *lists[i], vecPatches );
+                else              SyncVectorPatch::exchange2( *lists[i], vecPatches );
+            }
+            for (unsigned int i=ifirst ; i<ifirst+3 ; i++) {
+                if      (iDim==0) SyncVectorPatch::finalizeexchange0( *lists[i], vecPatches );
+                else if (iDim==1) SyncVectorPatch::finalizeexchange1( *lists[i], vecPatches );
+                else              SyncVectorPatch::finalizeexchange2( *lists[i], vecPatches );
+            }
+        }
+    }
+
+}
+
 void SyncVectorPatch::finalizeexchangeB( VectorPatch& vecPatches )
 {
     if (vecPatches.listBx_[0]->dims_.size()==1) {
@@ -156,7 +186,7 @@ void SyncVectorPatch::finalizeexchangeB( VectorPatch& vecPatches )
 void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatches, Timers &timers, int itime )
 {
     unsigned int h0, oversize[3], n_space[3];
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     int nPatches( vecPatches.size() );
@@ -205,12 +235,15 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
         for (unsigned int ifield=istart ; ifield<iend ; ifield++) {
             int ipatch = vecPatches.LocalxIdx[ ifield-icomp*nFieldLocalx ];
             if (vecPatches(ipatch)->MPI_me_ == vecPatches(ipatch)->MPI_neighbor_[0][0]){
+                // Nothing to sum between two patches without currents
+                if ( vecPatches(ipatch)->EMfields->rhoJ_zero && vecPatches( vecPatches(ipatch)->neighbor_[0][0]-h0 )->EMfields->rhoJ_zero )
+                    continue;
                 pt1 = &(fields[ vecPatches(ipatch)->neighbor_[0][0]-h0+icomp*nPatches ]->data_[n_space[0]*ny_*nz_]);
                 pt2 = &(vecPatches.densitiesLocalx[ifield]->data_[0]);
                 //Sum 2 ==> 1
                 for (unsigned int i = 0; i < gsp[0]* ny_*nz_ ; i++) pt1[i] += pt2[i];
                 //Copy back the results to 2
-                memcpy( pt2, pt1, gsp[0]*ny_*nz_*sizeof(double)); 
+                memcpy( pt2, pt1, gsp[0]*ny_*nz_*sizeof(field_real)); 
             }
         }
     }
@@ -223,6 +256,7 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
         vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIx[ifield+nPatchMPIx  ], 0 ); // Jy
         vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0 ); // Jz
     }
+    updateRhoJZero( vecPatches, 0 );
     // END iDim = 0 sync
     // -----------------
 
@@ -263,12 +297,15 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
             for (unsigned int ifield=istart ; ifield<iend ; ifield++) {
                 int ipatch = vecPatches.LocalyIdx[ ifield-icomp*nFieldLocaly ];
                 if (vecPatches(ipatch)->MPI_me_ == vecPatches(ipatch)->MPI_neighbor_[1][0]){
+                    // Nothing to sum between two patches without currents
+                    if ( vecPatches(ipatch)->EMfields->rhoJ_zero && vecPatches( vecPatches(ipatch)->neighbor_[1][0]-h0 )->EMfields->rhoJ_zero )
+                        continue;
                     //The patch to the south belongs to the same MPI process than I.
                     pt1 = &(fields[vecPatches(ipatch)->neighbor_[1][0]-h0+icomp*nPatches]->data_[n_space[1]*nz_]);
                     pt2 = &(vecPatches.densitiesLocaly[ifield]->data_[0]);
                     for (unsigned int j = 0; j < nx_ ; j++){
                         for (unsigned int i = 0; i < gsp[1]*nz_ ; i++) pt1[i] += pt2[i];
-                        memcpy( pt2, pt1, gsp[1]*nz_*sizeof(double)); 
+                        memcpy( pt2, pt1, gsp[1]*nz_*sizeof(field_real)); 
                         pt1 += ny_*nz_;
                         pt2 += ny_*nz_;
                     }
@@ -284,6 +321,7 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
             vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1 ); // Jy
             vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1 ); // Jz
         }
+        updateRhoJZero( vecPatches, 1 );
         // END iDim = 1 sync
         // -----------------        
 
@@ -325,6 +363,9 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
                 for (unsigned int ifield=istart ; ifield<iend ; ifield++) {
                     int ipatch = vecPatches.LocalzIdx[ ifield-icomp*nFieldLocalz ];
                     if (vecPatches(ipatch)->MPI_me_ == vecPatches(ipatch)->MPI_neighbor_[2][0]){
+                        // Nothing to sum between two patches without currents
+                        if ( vecPatches(ipatch)->EMfields->rhoJ_zero && vecPatches( vecPatches(ipatch)->neighbor_[2][0]-h0 )->EMfields->rhoJ_zero )
+                            continue;
                         //The patch below me belongs to the same MPI process than I.
                         pt1 = &(fields[vecPatches(ipatch)->neighbor_[2][0]-h0+icomp*nPatches]->data_[n_space[2]]);
                         pt2 = &(vecPatches.densitiesLocalz[ifield]->data_[0]);
@@ -348,6 +389,7 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
                 vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2 ); // Jy
                 vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2 ); // Jz
             }
+            updateRhoJZero( vecPatches, 2 );
             // END iDim = 2 sync
             // -----------------
 
@@ -358,10 +400,37 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// After the sum of the currents in direction iDim, those of a patch may be non zero if those of one of its neighbours
+// in this direction were (the neighbours owned by other MPI processes are assumed to have some)
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::updateRhoJZero( VectorPatch& vecPatches, int iDim )
+{
+    #pragma omp single
+    {
+        unsigned int h0 = vecPatches(0)->hindex;
+        vector<bool> zero( vecPatches.size() );
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+            zero[ipatch] = vecPatches(ipatch)->EMfields->rhoJ_zero;
+            for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+                if ( vecPatches(ipatch)->neighbor_[iDim][iNeighbor]==MPI_PROC_NULL )
+                    continue;
+                if ( vecPatches(ipatch)->is_a_MPI_neighbor(iDim, iNeighbor) )
+                    zero[ipatch] = false;
+                else if ( !vecPatches( vecPatches(ipatch)->neighbor_[iDim][iNeighbor]-h0 )->EMfields->rhoJ_zero )
+                    zero[ipatch] = false;
+            }
+        }
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
+            vecPatches(ipatch)->EMfields->rhoJ_zero = zero[ipatch];
+    }
+}
+
+
 void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches, Timers &timers, int itime )
 {
     unsigned int nx_, ny_, nz_, h0, oversize[3], n_space[3], gsp[3];
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     int nPatches( vecPatches.size() );
@@ -413,7 +482,7 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
                 //Sum 2 ==> 1
                 for (unsigned int i = 0; i < gsp[0]* ny_*nz_ ; i++) pt1[i] += pt2[i];
                 //Copy back the results to 2
-                memcpy( pt2, pt1, gsp[0]*ny_*nz_*sizeof(double)); 
+                memcpy( pt2, pt1, gsp[0]*ny_*nz_*sizeof(field_real)); 
             }
         }
     }
@@ -466,7 +535,7 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
                     pt2 = &(*fields[ifield])(0);
                     for (unsigned int j = 0; j < nx_ ; j++){
                         for (unsigned int i = 0; i < gsp[1]*nz_ ; i++) pt1[i] += pt2[i];
-                        memcpy( pt2, pt1, gsp[1]*nz_*sizeof(double)); 
+                        memcpy( pt2, pt1, gsp[1]*nz_*sizeof(field_real)); 
                         pt1 += ny_*nz_;
                         pt2 += ny_*nz_;
                     }
@@ -552,7 +621,7 @@ void SyncVectorPatch::exchange( std::vector<Field*> fields, VectorPatch& vecPatc
 
 
     unsigned int nx_, ny_(1), nz_(1), h0, oversize[3], n_space[3], gsp[3];
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     oversize[0] = vecPatches(0)->EMfields->oversize[0];
@@ -579,8 +648,8 @@ void SyncVectorPatch::exchange( std::vector<Field*> fields, VectorPatch& vecPatc
         if (vecPatches(ipatch)->MPI_me_ == vecPatches(ipatch)->MPI_neighbor_[0][0]){
             pt1 = &(*fields[vecPatches(ipatch)->neighbor_[0][0]-h0])((n_space[0])*ny_*nz_);
             pt2 = &(*fields[ipatch])(0);
-            memcpy( pt2, pt1, oversize[0]*ny_*nz_*sizeof(double)); 
-            memcpy( pt1+gsp[0]*ny_*nz_, pt2+gsp[0]*ny_*nz_, oversize[0]*ny_*nz_*sizeof(double)); 
+            memcpy( pt2, pt1, oversize[0]*ny_*nz_*sizeof(field_real)); 
+            memcpy( pt1+gsp[0]*ny_*nz_, pt2+gsp[0]*ny_*nz_, oversize[0]*ny_*nz_*sizeof(field_real)); 
         } // End if ( MPI_me_ == MPI_neighbor_[0][0] ) 
 
         if (fields[0]->dims_.size()>1) {
@@ -636,7 +705,7 @@ void SyncVectorPatch::exchange0( std::vector<Field*> fields, VectorPatch& vecPat
         vecPatches(ipatch)->initExchange( fields[ipatch], 0 );
 
     unsigned int ny_(1), nz_(1), h0, oversize, n_space, gsp;
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     oversize = vecPatches(0)->EMfields->oversize[0];
@@ -659,11 +728,11 @@ void SyncVectorPatch::exchange0( std::vector<Field*> fields, VectorPatch& vecPat
         if (vecPatches(ipatch)->MPI_me_ == vecPatches(ipatch)->MPI_neighbor_[0][0]){
             pt1 = &(*fields[vecPatches(ipatch)->neighbor_[0][0]-h0])(n_space*ny_*nz_);
             pt2 = &(*fields[ipatch])(0);
-            //memcpy( pt2, pt1, ny_*sizeof(double)); 
-            //memcpy( pt1+gsp[0]*ny_, pt2+gsp[0]*ny_, ny_*sizeof(double)); 
+            //memcpy( pt2, pt1, ny_*sizeof(field_real)); 
+            //memcpy( pt1+gsp[0]*ny_, pt2+gsp[0]*ny_, ny_*sizeof(field_real)); 
             //for filter
-            memcpy( pt2, pt1, oversize*ny_*nz_*sizeof(double)); 
-            memcpy( pt1+gsp*ny_*nz_, pt2+gsp*ny_*nz_, oversize*ny_*nz_*sizeof(double)); 
+            memcpy( pt2, pt1, oversize*ny_*nz_*sizeof(field_real)); 
+            memcpy( pt1+gsp*ny_*nz_, pt2+gsp*ny_*nz_, oversize*ny_*nz_*sizeof(field_real)); 
         } // End if ( MPI_me_ == MPI_neighbor_[0][0] ) 
 
 
@@ -683,7 +752,7 @@ void SyncVectorPatch::new_exchange0( std::vector<Field*>& fields, VectorPatch& v
 
 
     unsigned int h0, oversize, n_space;
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     oversize = vecPatches(0)->EMfields->oversize[0];
@@ -715,8 +784,8 @@ void SyncVectorPatch::new_exchange0( std::vector<Field*>& fields, VectorPatch& v
                 pt1 = &(fields[vecPatches(ipatch)->neighbor_[0][0]-h0+icomp*nPatches]->data_[n_space*ny_*nz_]);
                 pt2 = &(vecPatches.B_localx[ifield]->data_[0]);
                 //for filter
-                memcpy( pt2, pt1, oversize*ny_*nz_*sizeof(double)); 
-                memcpy( pt1+gsp*ny_*nz_, pt2+gsp*ny_*nz_, oversize*ny_*nz_*sizeof(double)); 
+                memcpy( pt2, pt1, oversize*ny_*nz_*sizeof(field_real)); 
+                memcpy( pt1+gsp*ny_*nz_, pt2+gsp*ny_*nz_, oversize*ny_*nz_*sizeof(field_real)); 
             } // End if ( MPI_me_ == MPI_neighbor_[0][0] ) 
 
         } // End for( ipatch )
@@ -755,7 +824,7 @@ void SyncVectorPatch::new_exchange1( std::vector<Field*>& fields, VectorPatch& v
     }
 
     unsigned int h0, oversize, n_space;
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     oversize = vecPatches(0)->EMfields->oversize[1];
@@ -805,7 +874,7 @@ void SyncVectorPatch::exchange1( std::vector<Field*> fields, VectorPatch& vecPat
         vecPatches(ipatch)->initExchange( fields[ipatch], 1 );
 
     unsigned int nx_, ny_, nz_(1), h0, oversize, n_space, gsp;
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     oversize = vecPatches(0)->EMfields->oversize[1];
@@ -872,7 +941,7 @@ void SyncVectorPatch::new_exchange2( std::vector<Field*> fields, VectorPatch& ve
     }
 
     unsigned int h0, oversize, n_space;
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     oversize = vecPatches(0)->EMfields->oversize[2];
@@ -923,7 +992,7 @@ void SyncVectorPatch::exchange2( std::vector<Field*> fields, VectorPatch& vecPat
         vecPatches(ipatch)->initExchange( fields[ipatch], 2 );
 
     unsigned int nx_, ny_, nz_, h0, oversize, n_space, gsp;
-    double *pt1,*pt2;
+    field_real *pt1,*pt2;
     h0 = vecPatches(0)->hindex;
 
     oversize = vecPatches(0)->EMfields->oversize[2];
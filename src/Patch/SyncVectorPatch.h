@@ -21,9 +21,12 @@ public :
     static void finalizeexchangeE( VectorPatch& vecPatches );
     static void exchangeB( VectorPatch& vecPatches );
     static void exchangeJ( VectorPatch& vecPatches );
+    //! Exchange all the components of E and B, direction by direction (see Params::exchange_fields_each)
+    static void exchangeEB( VectorPatch& vecPatches );
     static void finalizeexchangeB( VectorPatch& vecPatches );
     static void sum      ( std::vector<Field*> fields, VectorPatch& vecPatches, Timers &timers, int itime );
     static void new_sum      ( std::vector<Field*>& fields, VectorPatch& vecPatches, Timers &timers, int itime );
+    static void updateRhoJZero( VectorPatch& vecPatches, int iDim );
     static void exchange ( std::vector<Field*> fields, VectorPatch& vecPatches );
     static void finalizeexchange( std::vector<Field*> fields, VectorPatch& vecPatches );
     static void exchange0( std::vector<Field*> fields, VectorPatch& vecPatches );
@@ -5,6 +5,8 @@
 #include <iomanip>
 #include <fstream>
 #include <cstring>
+#include <limits>
+#include <cmath>
 //#include <string>
 
 #include "Hilbert_functions.h"
@@ -24,6 +26,7 @@ using namespace std;
 
 VectorPatch::VectorPatch()
 {
+    fieldsExchangeNeeded = true;
 }
 
 
@@ -105,8 +108,25 @@ void VectorPatch::dynamics(Params& params, SmileiMPI* smpi, SimWindow* simWindow
     #pragma omp for schedule(runtime)
     for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
         (*this)(ipatch)->EMfields->restartRhoJ();
+        // Decided before moving any species, as ionization adds particles to other species
         for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
-            if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  ) {
+            Species* spec = species(ipatch, ispec);
+            spec->bins_shared = spec->split_patch_threshold>0 && spec->getNbrOfParticles()>spec->split_patch_threshold;
+            spec->random.reset( Random::dynamics_stream, ispec, itime );
+            // Only the particles contribute to the currents and densities
+            if ( spec->getNbrOfParticles()>0 )
+                (*this)(ipatch)->EMfields->rhoJ_zero = false;
+        }
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+            // Nothing to move (nor to exchange) in an empty species
+            // (checked now, as the ionization of the previous species may have added some)
+            species(ipatch, ispec)->empty = species(ipatch, ispec)->getNbrOfParticles()==0;
+            if ( species(ipatch, ispec)->empty ) {
+                species(ipatch, ispec)->clearExchList();
+                continue;
+            }
+            if ( ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag )
+                 && !species(ipatch, ispec)->bins_shared ) {
                 species(ipatch, ispec)->dynamics(time_dual, ispec,
                                                  emfields(ipatch), interp(ipatch), proj(ipatch),
                                                  params, diag_flag, partwalls(ipatch),
@@ -115,6 +135,20 @@ void VectorPatch::dynamics(Params& params, SmileiMPI* smpi, SimWindow* simWindow
         }
     
     }
+    
+    // Patches too dense to be handled by a single thread : all threads process their bins together
+    // (after the loop above, so that all the densities have been restarted)
+    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+            if ( ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag )
+                 && species(ipatch, ispec)->bins_shared ) {
+                species(ipatch, ispec)->dynamics_shared(time_dual, ispec,
+                                                        emfields(ipatch), proj(ipatch),
+                                                        params, diag_flag, partwalls(ipatch),
+                                                        (*this)(ipatch), smpi);
+            }
+        }
+    }
     timers.particles.update( params.printNow( itime ) );
 
 //    timers.syncField.restart();
@@ -147,7 +181,8 @@ void VectorPatch::finalize_and_sort_parts(Params& params, SmileiMPI* smpi, SimWi
             (*this)(ipatch)->cleanParticlesOverhead(params);
     timers.syncPart.update( params.printNow( itime ) );
 
-    if (itime!=0) {
+    // (exchangeEB is complete when solveMaxwell returns, nothing was exchanged if the fields are frozen)
+    if ( itime!=0 && time_dual > params.time_fields_frozen && params.exchange_fields_each==1 ) {
         timers.syncField.restart();
         SyncVectorPatch::finalizeexchangeB( (*this) );
         timers.syncField.update(  params.printNow( itime ) );
@@ -164,6 +199,7 @@ void VectorPatch::computeCharge()
         for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
             species(ipatch, ispec)->computeCharge(ispec, emfields(ipatch), proj(ipatch) );
         }
+        (*this)(ipatch)->EMfields->rhoJ_zero = false;
     }
 
 } // END computeRho
@@ -212,12 +248,26 @@ void VectorPatch::solveMaxwell(Params& params, SimWindow* simWindow, int itime,
         for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
             // Current spatial filtering
             (*this)(ipatch)->EMfields->binomialCurrentFilter();
+            // (the exchange may bring currents in the ghost cells)
+            (*this)(ipatch)->EMfields->rhoJ_zero = false;
         }
         SyncVectorPatch::exchangeJ( (*this) );
     }
     
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
+        ElectroMagn* EMfields = (*this)(ipatch)->EMfields;
+        if ( EMfields->fusedMaxwell ) {
+            // Computes E and B at time n+1 in a single pass. B_m stores B at time n+1/2, except on the
+            // planes modified by the boundary conditions where B at time n is centered afterwards.
+            bool bc = EMfields->setBoundaryConditionsWidth(time_dual, (*this)(ipatch), simWindow);
+            EMfields->solveMaxwellFused();
+            if ( bc ) {
+                EMfields->boundaryConditions(itime, time_dual, (*this)(ipatch), params, simWindow);
+                EMfields->centerMagneticFieldsOnBorders();
+            }
+            continue;
+        }
         // Saving magnetic fields (to compute centered fields used in the particle pusher)
         // Stores B at time n in B_m.
         (*this)(ipatch)->EMfields->saveMagneticFields();
@@ -237,7 +287,16 @@ void VectorPatch::solveMaxwell(Params& params, SimWindow* simWindow, int itime,
     timers.maxwell.update( params.printNow( itime ) );
     
     timers.syncField.restart();
-    SyncVectorPatch::exchangeB( (*this) );
+    if ( params.exchange_fields_each == 1 ) {
+        SyncVectorPatch::exchangeB( (*this) );
+    }
+    else if ( itime%params.exchange_fields_each == 0 || fieldsExchangeNeeded ) {
+        // Time blocking: the guard cells being exchange_fields_each-1 cells wider, the solver can advance
+        // exchange_fields_each timesteps before the errors of their outer cells reach those used by the particles
+        SyncVectorPatch::exchangeEB( (*this) );
+        #pragma omp single
+        fieldsExchangeNeeded = false;
+    }
     timers.syncField.update(  params.printNow( itime ) );
 
 } // END solveMaxwell
@@ -376,7 +435,27 @@ bool VectorPatch::isRhoNull( SmileiMPI* smpi )
     
     MPI_Allreduce(&locnorm2, &norm2, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
     
+#ifdef __SINGLE_FIELDS
+    // In single precision, the densities of the species of a neutral plasma do not cancel exactly in rho :
+    // rho is null if it is below their rounding errors (the periodic Poisson problem would have no solution)
+    double locsum[2] = {0., 0.}; // absolute charge of the particles, number of cells
+    for (unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++) {
+        ElectroMagn* EMfields = (*this)(ipatch)->EMfields;
+        locsum[1] += (double)EMfields->n_space[0] * EMfields->n_space[1] * EMfields->n_space[2];
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+            Particles* particles = (*this)(ipatch)->vecSpecies[ispec]->particles;
+            if ( particles->isTest ) continue;
+            for (unsigned int ipart=0 ; ipart<particles->size() ; ipart++)
+                locsum[0] += std::abs( particles->charge(ipart) * particles->weight(ipart) );
+        }
+    }
+    double sum[2];
+    MPI_Allreduce(locsum, sum, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    double rounding = 10. * std::numeric_limits<field_real>::epsilon() * sum[0] / sum[1];
+    return ( norm2 <= rounding*rounding*sum[1] );
+#else
     return (norm2<=0.);
+#endif
 } // END isRhoNull
 
 
@@ -467,6 +546,12 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI* smpi )
         // compute control parameter
         ctrl = rnew_dot_rnew / (double)(nx_p2_global);
         if (smpi->isMaster()) DEBUG("iteration " << iteration << " done, exiting with control parameter ctrl = " << ctrl);
+        
+        // Without solution (e.g. a charged plasma with periodic boundaries), the residual grows until it overflows,
+        // much sooner with single_fields. A NaN would end the loop as if the solver had converged.
+        if ( !std::isfinite(ctrl) )
+            ERROR("Poisson solver diverged at iteration " << iteration << " (non-finite residual): "
+                  << "the initial charge must be neutral with periodic boundaries, or set solve_poisson = False");
     
     }//End of the iterative loop
     
@@ -740,7 +825,7 @@ void VectorPatch::exchangePatches(SmileiMPI* smpi, Params& params)
     int oldMPIrank = smpi->getRank() -1;
     int istart = 0;
     int nmax_laser = 4;
-    int nmessage = 2*nSpecies+(2+params.nDim_particle)*(*this)(0)->probes.size()+
+    int nmessage = 2*nSpecies+(*this)(0)->vecCollisions.size()+(2+params.nDim_particle)*(*this)(0)->probes.size()+
         9+(*this)(0)->EMfields->antennas.size()+4*nmax_laser;
     
     
@@ -830,6 +915,9 @@ void VectorPatch::output_exchanges(SmileiMPI* smpi)
 //! Resize vector of field*
 void VectorPatch::update_field_list()
 {
+    // The guard cells of the new patches and of their neighbours are not up to date
+    fieldsExchangeNeeded = true;
+    
     int nDim = patches_[0]->EMfields->Ex_->dims_.size();
     densities.resize( 3*size() ) ; // Jx + Jy + Jz
 
@@ -1089,13 +1177,18 @@ void VectorPatch::applyCollisions(Params& params, int itime, Timers & timers)
 {
     timers.collisions.restart();
     
-    if (Collisions::debye_length_required)
-        #pragma omp for schedule(static)
-        for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
-            Collisions::calculate_debye_length(params,patches_[ipatch]);
-    
     unsigned int ncoll = patches_[0]->vecCollisions.size();
     
+    // The Debye length is only needed in the patches where some collisions are applied at this timestep
+    #pragma omp for schedule(static)
+    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++) {
+        bool applied = false;
+        for (unsigned int icoll=0 ; icoll<ncoll; icoll++)
+            applied |= patches_[ipatch]->vecCollisions[icoll]->isApplied(params,itime);
+        if (applied && Collisions::debye_length_required)
+            Collisions::calculate_debye_length(params,patches_[ipatch]);
+    }
+    
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
         for (unsigned int icoll=0 ; icoll<ncoll; icoll++)
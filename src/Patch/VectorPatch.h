@@ -188,6 +188,10 @@ public :
     //! True if any antennas
     unsigned int nAntennas;
     
+    //! True if E and B must be exchanged at the next timestep whatever Params::exchange_fields_each
+    //! (patches created, moved or exchanged)
+    bool fieldsExchangeNeeded;
+    
     //! 1st patch index of patches_ (stored for balancing op)
     int refHindex_;
     
@@ -2,8 +2,157 @@
 
 #include "Params.h"
 #include "Patch.h"
+#include "ElectroMagn.h"
+#include "SmileiMPI.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
 
 Projector::Projector(Params &params, Patch* patch)
 {
 }
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Arrays receiving the densities : Jx, Jy, Jz, and rho on diag timesteps (NULL otherwise)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector::projected_fields(ElectroMagn* EMfields, bool diag_flag, int ispec, Field** fields)
+{
+    if (!diag_flag) {
+        fields[0] = EMfields->Jx_;
+        fields[1] = EMfields->Jy_;
+        fields[2] = EMfields->Jz_;
+        fields[3] = NULL;
+    } else {
+        fields[0] = EMfields->Jx_s [ispec] ? EMfields->Jx_s [ispec] : EMfields->Jx_ ;
+        fields[1] = EMfields->Jy_s [ispec] ? EMfields->Jy_s [ispec] : EMfields->Jy_ ;
+        fields[2] = EMfields->Jz_s [ispec] ? EMfields->Jz_s [ispec] : EMfields->Jz_ ;
+        fields[3] = EMfields->rho_s[ispec] ? EMfields->rho_s[ispec] : EMfields->rho_;
+    }
+}
+
+void Projector::patch_densities(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, bool diag_flag, int ispec, Field** fields, field_real** J)
+{
+    projected_fields(EMfields, diag_flag, ispec, fields);
+    
+    field_real* tile = smpi->dynamics_Jthread[ithread].empty() ? NULL : smpi->dynamics_Jthread[ithread].data();
+    for (unsigned int i=0 ; i<4 ; i++) {
+        if (!fields[i])
+            J[i] = NULL;
+        else if (tile) {
+            J[i] = tile;
+            tile += fields[i]->globalDims_;
+        } else
+            J[i] = fields[i]->data_;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// A bin covers b_dim[0] rows (first index) of each array : the tile holds these rows for Jx, Jy, Jz and rho,
+// with the same layout as the patch arrays, so that the projectors index both the same way
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector::open_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+{
+    Field* fields[4];
+    projected_fields(EMfields, diag_flag, ispec, fields);
+    
+    unsigned int size = 0;
+    for (unsigned int i=0 ; i<4 ; i++)
+        if (fields[i])
+            size += b_dim[0] * (fields[i]->globalDims_/fields[i]->dims_[0]);
+    
+    smpi->dynamics_Jtile[ithread].assign(size, 0.);
+    smpi->dynamics_Jtile_bin[ithread] = ibin;
+}
+
+void Projector::close_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+{
+    Field* fields[4];
+    field_real* J[4];
+    patch_densities(EMfields, smpi, ithread, diag_flag, ispec, fields, J);
+    
+    field_real* tile = smpi->dynamics_Jtile[ithread].data();
+    for (unsigned int i=0 ; i<4 ; i++) {
+        if (!fields[i]) continue;
+        unsigned int row = fields[i]->globalDims_/fields[i]->dims_[0];
+        // The last bin may cover less rows than b_dim[0] for the primal arrays
+        unsigned int nrows = min( b_dim[0], fields[i]->dims_[0]-ibin*clrw );
+        field_real* b_field = J[i] + ibin*clrw*row;
+        for (unsigned int j=0 ; j<nrows*row ; j++)
+            b_field[j] += tile[j];
+        tile += b_dim[0]*row;
+    }
+    
+    smpi->dynamics_Jtile_bin[ithread] = -1;
+}
+
+void Projector::bin_densities(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, field_real** b_J)
+{
+    Field* fields[4];
+    field_real* J[4];
+    patch_densities(EMfields, smpi, ithread, diag_flag, ispec, fields, J);
+    
+    bool tiled = ( smpi->dynamics_Jtile_bin[ithread] == ibin );
+    field_real* tile = smpi->dynamics_Jtile[ithread].data();
+    for (unsigned int i=0 ; i<4 ; i++) {
+        if (!fields[i]) {
+            b_J[i] = NULL;
+            continue;
+        }
+        unsigned int row = fields[i]->globalDims_/fields[i]->dims_[0];
+        if (tiled) {
+            b_J[i] = tile;
+            tile += b_dim[0]*row;
+        } else
+            b_J[i] = J[i] + ibin*clrw*row;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// When the bins of a patch are shared among the threads, two threads may project on the same nodes (bins overlap) :
+// each thread accumulates in a private copy of the patch densities, the copies being summed once all bins are done
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector::open_thread_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, bool diag_flag, int ispec)
+{
+    Field* fields[4];
+    projected_fields(EMfields, diag_flag, ispec, fields);
+    
+    unsigned int size = 0;
+    for (unsigned int i=0 ; i<4 ; i++)
+        if (fields[i])
+            size += fields[i]->globalDims_;
+    
+    smpi->dynamics_Jthread[ithread].assign(size, 0.);
+}
+
+void Projector::reduce_thread_tiles(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, bool diag_flag, int ispec)
+{
+    int nthreads = 1;
+    #ifdef _OPENMP
+        nthreads = omp_get_num_threads();
+    #endif
+    
+    Field* fields[4];
+    projected_fields(EMfields, diag_flag, ispec, fields);
+    
+    // Each thread sums a part of the nodes over all the copies
+    unsigned int offset = 0;
+    for (unsigned int i=0 ; i<4 ; i++) {
+        if (!fields[i]) continue;
+        field_real* field = fields[i]->data_;
+        #pragma omp for schedule(static)
+        for (unsigned int j=0 ; j<fields[i]->globalDims_ ; j++) {
+            double sum = 0.;
+            for (int ithd=0 ; ithd<nthreads ; ithd++)
+                sum += smpi->dynamics_Jthread[ithd][offset+j];
+            field[j] += sum;
+        }
+        offset += fields[i]->globalDims_;
+    }
+    
+    // All the copies have been read (barrier of the loops above)
+    smpi->dynamics_Jthread[ithread].clear();
+}
@@ -25,14 +25,38 @@ public:
     virtual void setMvWinLimits(unsigned int shift) = 0;
 
     //! Project global current charge (EMfields->rho_), frozen & diagFields timestep
-    virtual void operator() (double* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim) = 0;
+    virtual void operator() (field_real* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim) = 0;
 
     //! Project global current densities if Ionization in Species::dynamics,
     virtual void operator() (Field* Jx, Field* Jy, Field* Jz, Particles &particles, int ipart, LocalFields Jion) = 0;
 
-   //!Wrapper
-    virtual void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec) = 0;
+   //!Wrapper (the smpi buffers of particle ipart are at index ipart-ipart_ref)
+    virtual void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref = 0) = 0;
+
+    //! Vectorized wrapper (same arguments), the projectors without a vectorized version using the wrapper above
+    virtual void vectorized(ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref = 0) {
+        (*this)(EMfields, particles, smpi, istart, iend, ithread, ibin, clrw, diag_flag, b_dim, ispec, ipart_ref);
+    };
+
+    //! Next projections of bin ibin are accumulated in the (zeroed) tile of thread ithread
+    void open_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec);
+    //! Add the tile of thread ithread to the densities of bin ibin, next projections are done on the patch arrays
+    void close_bin_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec);
+
+    //! Next projections of thread ithread (any bin) are accumulated in its (zeroed) private copy of the patch densities
+    void open_thread_tile(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, bool diag_flag, int ispec);
+    //! Sum the private copies of all the threads in the patch arrays (called by all the threads of the team)
+    void reduce_thread_tiles(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, bool diag_flag, int ispec);
+
+protected:
+    //! Pointers to the densities of bin ibin (Jx, Jy, Jz, and rho if diag_flag): in the tile of thread ithread if opened, else in the patch arrays
+    void bin_densities(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, field_real** b_J);
+
 private:
+    //! Arrays receiving the densities of species ispec (species-specific arrays on diag timesteps, if any)
+    void projected_fields(ElectroMagn* EMfields, bool diag_flag, int ispec, Field** fields);
+    //! Pointers to the start of the densities written by thread ithread: its private copy if opened, else the patch arrays
+    void patch_densities(ElectroMagn* EMfields, SmileiMPI* smpi, int ithread, bool diag_flag, int ispec, Field** fields, field_real** J);
 
 };
 
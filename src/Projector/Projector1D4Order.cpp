@@ -46,7 +46,7 @@ Projector1D4Order::~Projector1D4Order()
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project current densities : main projector
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector1D4Order::operator() (double* Jx, double* Jy, double* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* delta)
+void Projector1D4Order::operator() (field_real* Jx, field_real* Jy, field_real* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* delta)
 {
     // Declare local variables
     int ipo, ip;
@@ -134,7 +134,7 @@ void Projector1D4Order::operator() (double* Jx, double* Jy, double* Jz, Particle
 // ---------------------------------------------------------------------------------------------------------------------
 //!  Project current densities & charge : diagFields timstep
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector1D4Order::operator() (double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* delta)
+void Projector1D4Order::operator() (field_real* Jx, field_real* Jy, field_real* Jz, field_real* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* delta)
 {
     // Declare local variables
     int ipo, ip;
@@ -223,7 +223,7 @@ void Projector1D4Order::operator() (double* Jx, double* Jy, double* Jz, double*
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project charge : frozen & diagFields timstep
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector1D4Order::operator() (double* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim)
+void Projector1D4Order::operator() (field_real* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim)
 {
 
     //Warning : this function is used for frozen species only. It is assumed that position = position_old !!!
@@ -288,29 +288,25 @@ void Projector1D4Order::operator() (Field* Jx, Field* Jy, Field* Jz, Particles &
 } // END Project global current densities (ionize)
 
 
-void Projector1D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+void Projector1D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref)
 {
     std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
     std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
     std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
     
-    // If no field diagnostics this timestep, then the projection is done directly on the total arrays
+    // Densities of the bin, in the patch arrays (species-specific arrays on diag timesteps) or in the thread's bin tile
+    field_real* b_J[4];
+    bin_densities(EMfields, smpi, ithread, ibin, clrw, diag_flag, b_dim, ispec, b_J);
+    
+    // If no field diagnostics this timestep, only the currents are projected
     if (!diag_flag){ 
-        double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw);
-        double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw);
-        double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw);
         for (int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart]);
+            (*this)(b_J[0], b_J[1], b_J[2], particles,  ipart, (*invgf)[ipart-ipart_ref], ibin*clrw, b_dim, &(*iold)[ipart-ipart_ref], &(*delta)[ipart-ipart_ref]);
             
-    // Otherwise, the projection may apply to the species-specific arrays
+    // Otherwise, the charge is projected as well
     } else {
-        double* b_Jx  = EMfields->Jx_s [ispec] ? &(*EMfields->Jx_s [ispec])(ibin*clrw) : &(*EMfields->Jx_ )(ibin*clrw) ;
-        double* b_Jy  = EMfields->Jy_s [ispec] ? &(*EMfields->Jy_s [ispec])(ibin*clrw) : &(*EMfields->Jy_ )(ibin*clrw) ;
-        double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw) : &(*EMfields->Jz_ )(ibin*clrw) ;
-        double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw) : &(*EMfields->rho_)(ibin*clrw) ;
         for (int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart]);
+            (*this)(b_J[0], b_J[1], b_J[2], b_J[3], particles,  ipart, (*invgf)[ipart-ipart_ref], ibin*clrw, b_dim, &(*iold)[ipart-ipart_ref], &(*delta)[ipart-ipart_ref]);
     }
-
 }
 
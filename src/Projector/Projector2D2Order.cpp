@@ -1,6 +1,7 @@
 #include "Projector2D2Order.h"
 
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 
 #include "ElectroMagn.h"
@@ -43,7 +44,7 @@ Projector2D2Order::~Projector2D2Order()
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project current densities : main projector
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+void Projector2D2Order::operator() (field_real* Jx, field_real* Jy, field_real* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
 {
     
     // -------------------------------------
@@ -171,7 +172,7 @@ void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, Particle
 // ---------------------------------------------------------------------------------------------------------------------
 //!  Project current densities & charge : diagFields timstep
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+void Projector2D2Order::operator() (field_real* Jx, field_real* Jy, field_real* Jz, field_real* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
 {
     
     // -------------------------------------
@@ -305,7 +306,7 @@ void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, double*
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project charge : frozen & diagFields timstep
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector2D2Order::operator() (double* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim)
+void Projector2D2Order::operator() (field_real* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim)
 {
     //Warning : this function is used for frozen species only. It is assumed that position = position_old !!!
     
@@ -452,29 +453,227 @@ void Projector2D2Order::operator() (Field* Jx, Field* Jy, Field* Jz, Particles &
 // ---------------------------------------------------------------------------------------------------------------------
 //! Wrapper for projection
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref)
 {
     std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
     std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
     std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
     
-    int dim1 = EMfields->dimPrim[1];
+    // Densities of the bin, in the patch arrays (species-specific arrays on diag timesteps) or in the thread's bin tile
+    field_real* b_J[4];
+    bin_densities(EMfields, smpi, ithread, ibin, clrw, diag_flag, b_dim, ispec, b_J);
     
-    // If no field diagnostics this timestep, then the projection is done directly on the total arrays
+    // If no field diagnostics this timestep, only the currents are projected
     if (!diag_flag){ 
-        double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw*dim1);
-        double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1));
-        double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw*dim1);
         for (int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[2*ipart], &(*delta)[2*ipart]);
+            (*this)(b_J[0], b_J[1], b_J[2], particles,  ipart, (*invgf)[ipart-ipart_ref], ibin*clrw, b_dim, &(*iold)[2*(ipart-ipart_ref)], &(*delta)[2*(ipart-ipart_ref)]);
             
-    // Otherwise, the projection may apply to the species-specific arrays
+    // Otherwise, the charge is projected as well
     } else {
-        double* b_Jx  = EMfields->Jx_s [ispec] ? &(*EMfields->Jx_s [ispec])(ibin*clrw* dim1   ) : &(*EMfields->Jx_ )(ibin*clrw* dim1   ) ;
-        double* b_Jy  = EMfields->Jy_s [ispec] ? &(*EMfields->Jy_s [ispec])(ibin*clrw*(dim1+1)) : &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)) ;
-        double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw* dim1   ) : &(*EMfields->Jz_ )(ibin*clrw* dim1   ) ;
-        double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   ) : &(*EMfields->rho_)(ibin*clrw* dim1   ) ;
         for (int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[2*ipart], &(*delta)[2*ipart]);
+            (*this)(b_J[0], b_J[1], b_J[2], b_J[3], particles,  ipart, (*invgf)[ipart-ipart_ref], ibin*clrw, b_dim, &(*iold)[2*(ipart-ipart_ref)], &(*delta)[2*(ipart-ipart_ref)]);
     }
 }
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Vectorized wrapper : same Esirkepov scheme as the main projector, computed for batch_size particles at once
+//!   - the coefficients S0, S1, DS of the batch are stored by node (Sx0[i*batch_size+ipart])
+//!   - the 5x5 stencils of Jx, Jy, Jz (and rho) are computed in loops over the particles of the batch
+//!   - the stencils of consecutive particles in the same cell are summed, then added once to the arrays
+//! With particles sorted by cell, the arrays are written once per cell instead of once per particle
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D2Order::vectorized(ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref)
+{
+    int* iold = smpi->dynamics_iold[ithread].data();
+    double* deltaold = smpi->dynamics_deltaold[ithread].data();
+    double* invgf = smpi->dynamics_invgf[ithread].data();
+    
+    // Densities of the bin (rho only if diag_flag)
+    field_real* b_J[4];
+    bin_densities(EMfields, smpi, ithread, ibin, clrw, diag_flag, b_dim, ispec, b_J);
+    field_real* Jx  = b_J[0];
+    field_real* Jy  = b_J[1];
+    field_real* Jz  = b_J[2];
+    field_real* rho = b_J[3];
+    
+    double* position_x = &( particles.position(0, 0) );
+    double* position_y = &( particles.position(1, 0) );
+    particle_real* momentum_z = &( particles.momentum(2, 0) );
+    particle_real* weight = &( particles.weight(0) );
+    short* charge = &( particles.charge(0) );
+    
+    // Esirkepov coefficients, stored by node
+    // (the stencils are computed for whole batches, the lanes after the last particle being ignored)
+    double Sx0[5*batch_size] = {}, Sx1[5*batch_size] = {}, DSx[5*batch_size] = {};
+    double Sy0[5*batch_size] = {}, Sy1[5*batch_size] = {}, DSy[5*batch_size] = {};
+    double charge_weight[batch_size] = {}, crz_p[batch_size] = {};
+    // Primal indices at the current timestep, then first node of the stencils (relative to the bin)
+    int ip[batch_size], jp[batch_size], ipo[batch_size], jpo[batch_size];
+    // Stencils of the particles, stored by node (i*5+j)
+    double Jx_p[25*batch_size], Jy_p[25*batch_size], Jz_p[25*batch_size], rho_p[25*batch_size];
+    
+    for (int ibatch=istart ; ibatch<iend ; ibatch+=batch_size) {
+        int n = min( batch_size, iend-ibatch );
+        
+        // locate the particles on the primal grid at current time-step
+        #pragma omp simd
+        for (int ipart=0 ; ipart<n ; ipart++) {
+            ip[ipart] = round( position_x[ibatch+ipart] * dx_inv_ );
+            jp[ipart] = round( position_y[ibatch+ipart] * dy_inv_ );
+        }
+        
+        // --------------------------------------------------------
+        // Calculate Esirkepov coef. S0, S1 and DS
+        // --------------------------------------------------------
+        #pragma omp simd
+        for (int ipart=0 ; ipart<n ; ipart++) {
+            int ibuf = ibatch+ipart-ipart_ref;
+            
+            double cw = (double)(charge[ibatch+ipart])*weight[ibatch+ipart];
+            charge_weight[ipart] = cw;
+            crz_p[ipart] = cw*momentum_z[ibatch+ipart]*invgf[ibuf];
+            
+            // former time-step
+            double delta = deltaold[2*ibuf];
+            double delta2 = delta*delta;
+            Sx0[              ipart] = 0.;
+            Sx0[  batch_size+ipart] = 0.5 * (delta2-delta+0.25);
+            Sx0[2*batch_size+ipart] = 0.75-delta2;
+            Sx0[3*batch_size+ipart] = 0.5 * (delta2+delta+0.25);
+            Sx0[4*batch_size+ipart] = 0.;
+            
+            delta = deltaold[2*ibuf+1];
+            delta2 = delta*delta;
+            Sy0[              ipart] = 0.;
+            Sy0[  batch_size+ipart] = 0.5 * (delta2-delta+0.25);
+            Sy0[2*batch_size+ipart] = 0.75-delta2;
+            Sy0[3*batch_size+ipart] = 0.5 * (delta2+delta+0.25);
+            Sy0[4*batch_size+ipart] = 0.;
+            
+            // current time-step : the 3 non-zero coefficients are shifted by ip-ipo (-1, 0 or 1)
+            int ip_m_ipo = ip[ipart]-iold[2*ibuf]-i_domain_begin;
+            delta  = position_x[ibatch+ipart] * dx_inv_ - (double)ip[ipart];
+            delta2 = delta*delta;
+            double s0 = 0.5 * (delta2-delta+0.25);
+            double s1 = 0.75-delta2;
+            double s2 = 0.5 * (delta2+delta+0.25);
+            for (int i=0 ; i<5 ; i++) {
+                int m = i-1-ip_m_ipo;
+                Sx1[i*batch_size+ipart] = m==0 ? s0 : ( m==1 ? s1 : ( m==2 ? s2 : 0. ) );
+                DSx[i*batch_size+ipart] = Sx1[i*batch_size+ipart] - Sx0[i*batch_size+ipart];
+            }
+            
+            int jp_m_jpo = jp[ipart]-iold[2*ibuf+1]-j_domain_begin;
+            delta  = position_y[ibatch+ipart] * dy_inv_ - (double)jp[ipart];
+            delta2 = delta*delta;
+            s0 = 0.5 * (delta2-delta+0.25);
+            s1 = 0.75-delta2;
+            s2 = 0.5 * (delta2+delta+0.25);
+            for (int j=0 ; j<5 ; j++) {
+                int m = j-1-jp_m_jpo;
+                Sy1[j*batch_size+ipart] = m==0 ? s0 : ( m==1 ? s1 : ( m==2 ? s2 : 0. ) );
+                DSy[j*batch_size+ipart] = Sy1[j*batch_size+ipart] - Sy0[j*batch_size+ipart];
+            }
+            
+            //This minus 2 come from the order 2 scheme, based on a 5 points stencil from -2 to +2.
+            ipo[ipart] = iold[2*ibuf] - ibin*clrw - 2;
+            jpo[ipart] = iold[2*ibuf+1] - 2;
+        }
+        
+        // ------------------------------------------------
+        // Local current created by the particles
+        // calculate using the charge conservation equation
+        // ------------------------------------------------
+        
+        // Jx, accumulated along x
+        for (int j=0 ; j<5 ; j++) {
+            #pragma omp simd
+            for (int ipart=0 ; ipart<batch_size ; ipart++)
+                Jx_p[j*batch_size+ipart] = 0.;
+        }
+        for (int i=1 ; i<5 ; i++) {
+            for (int j=0 ; j<5 ; j++) {
+                #pragma omp simd
+                for (int ipart=0 ; ipart<batch_size ; ipart++) {
+                    double crx_p = charge_weight[ipart]*dx_ov_dt;
+                    Jx_p[(i*5+j)*batch_size+ipart] = Jx_p[((i-1)*5+j)*batch_size+ipart]
+                        - crx_p * DSx[(i-1)*batch_size+ipart] * (Sy0[j*batch_size+ipart] + 0.5*DSy[j*batch_size+ipart]);
+                }
+            }
+        }
+        
+        // Jy, accumulated along y
+        for (int i=0 ; i<5 ; i++) {
+            #pragma omp simd
+            for (int ipart=0 ; ipart<batch_size ; ipart++)
+                Jy_p[i*5*batch_size+ipart] = 0.;
+            for (int j=1 ; j<5 ; j++) {
+                #pragma omp simd
+                for (int ipart=0 ; ipart<batch_size ; ipart++) {
+                    double cry_p = charge_weight[ipart]*dy_ov_dt;
+                    double tmpY = Sx0[i*batch_size+ipart] + 0.5*DSx[i*batch_size+ipart];
+                    Jy_p[(i*5+j)*batch_size+ipart] = Jy_p[(i*5+j-1)*batch_size+ipart] - cry_p * DSy[(j-1)*batch_size+ipart] * tmpY;
+                }
+            }
+        }
+        
+        // Jz (and rho)
+        for (int i=0 ; i<5 ; i++) {
+            for (int j=0 ; j<5 ; j++) {
+                #pragma omp simd
+                for (int ipart=0 ; ipart<batch_size ; ipart++) {
+                    double tmp2 = 0.5*Sx1[i*batch_size+ipart] + Sx0[i*batch_size+ipart];
+                    double tmp3 = 0.5*Sx0[i*batch_size+ipart] + Sx1[i*batch_size+ipart];
+                    Jz_p[(i*5+j)*batch_size+ipart] = crz_p[ipart] * one_third * ( Sy0[j*batch_size+ipart]*tmp2 + Sy1[j*batch_size+ipart]*tmp3 );
+                }
+                if (rho) {
+                    #pragma omp simd
+                    for (int ipart=0 ; ipart<batch_size ; ipart++)
+                        rho_p[(i*5+j)*batch_size+ipart] = charge_weight[ipart] * Sx1[i*batch_size+ipart]*Sy1[j*batch_size+ipart];
+                }
+            }
+        }
+        
+        // ---------------------------------------------------------------
+        // Sum the stencils of consecutive particles in the same cell, and
+        // add them to the arrays
+        // ---------------------------------------------------------------
+        for (int ifirst=0 ; ifirst<n ; ) {
+            int ilast = ifirst+1;
+            while ( ilast<n && ipo[ilast]==ipo[ifirst] && jpo[ilast]==jpo[ifirst] ) ilast++;
+            
+            double sJx[25], sJy[25], sJz[25], srho[25];
+            #pragma omp simd
+            for (int k=0 ; k<25 ; k++) {
+                sJx[k] = 0.; sJy[k] = 0.; sJz[k] = 0.; srho[k] = 0.;
+                for (int ipart=ifirst ; ipart<ilast ; ipart++) {
+                    sJx[k] += Jx_p[k*batch_size+ipart];
+                    sJy[k] += Jy_p[k*batch_size+ipart];
+                    sJz[k] += Jz_p[k*batch_size+ipart];
+                }
+            }
+            if (rho) {
+                for (int k=0 ; k<25 ; k++)
+                    for (int ipart=ifirst ; ipart<ilast ; ipart++)
+                        srho[k] += rho_p[k*batch_size+ipart];
+            }
+            
+            for (int i=0 ; i<5 ; i++) {
+                int iloc = (i+ipo[ifirst])*b_dim[1]+jpo[ifirst];
+                for (int j=0 ; j<5 ; j++) {
+                    Jx[iloc+j]  += sJx[i*5+j];
+                    Jy[iloc+j+i+ipo[ifirst]] += sJy[i*5+j]; //Because size of Jy in Y is b_dim[1]+1.
+                    Jz[iloc+j]  += sJz[i*5+j];
+                }
+                if (rho) {
+                    for (int j=0 ; j<5 ; j++)
+                        rho[iloc+j] += srho[i*5+j];
+                }
+            }
+            
+            ifirst = ilast;
+        }
+    }
+    
+} // END vectorized
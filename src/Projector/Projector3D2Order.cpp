@@ -1,6 +1,7 @@
 #include "Projector3D2Order.h"
 
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 
 #include "ElectroMagn.h"
@@ -46,7 +47,7 @@ Projector3D2Order::~Projector3D2Order()
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project local currents (sort)
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+void Projector3D2Order::operator() (field_real* Jx, field_real* Jy, field_real* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
 {
 
     // -------------------------------------
@@ -244,7 +245,7 @@ void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, Particle
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project local current densities (sort)
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+void Projector3D2Order::operator() (field_real* Jx, field_real* Jy, field_real* Jz, field_real* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
 {
 
     // -------------------------------------
@@ -456,7 +457,7 @@ void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, double*
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project local densities only (Frozen species)
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2Order::operator() (double* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim)
+void Projector3D2Order::operator() (field_real* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim)
 {
     //Warning : this function is used for frozen species only. It is assumed that position = position_old !!!
 
@@ -640,31 +641,188 @@ void Projector3D2Order::operator() (Field* Jx, Field* Jy, Field* Jz, Particles &
 } // END Project global current densities (ionize)
 
 //Wrapper for projection
-void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref)
 {
     std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
     std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
     std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
     
-    int dim1 = EMfields->dimPrim[1];
-    int dim2 = EMfields->dimPrim[2];
-
-    // If no field diagnostics this timestep, then the projection is done directly on the total arrays
+    // Densities of the bin, in the patch arrays (species-specific arrays on diag timesteps) or in the thread's bin tile
+    field_real* b_J[4];
+    bin_densities(EMfields, smpi, ithread, ibin, clrw, diag_flag, b_dim, ispec, b_J);
+    
+    // If no field diagnostics this timestep, only the currents are projected
     if (!diag_flag){ 
-        double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw* dim1   * dim2   );
-        double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)* dim2   );
-        double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw* dim1   *(dim2+1));
-        for ( int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[3*ipart], &(*delta)[3*ipart]);
+        for (int ipart=istart ; ipart<iend; ipart++ )
+            (*this)(b_J[0], b_J[1], b_J[2], particles,  ipart, (*invgf)[ipart-ipart_ref], ibin*clrw, b_dim, &(*iold)[3*(ipart-ipart_ref)], &(*delta)[3*(ipart-ipart_ref)]);
             
-    // Otherwise, the projection may apply to the species-specific arrays
+    // Otherwise, the charge is projected as well
     } else {
-        double* b_Jx  = EMfields->Jx_s [ispec] ? &(*EMfields->Jx_s [ispec])(ibin*clrw* dim1   *dim2) : &(*EMfields->Jx_ )(ibin*clrw* dim1   *dim2) ;
-        double* b_Jy  = EMfields->Jy_s [ispec] ? &(*EMfields->Jy_s [ispec])(ibin*clrw*(dim1+1)*dim2) : &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)*dim2) ;
-        double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw*dim1*(dim2+1)) : &(*EMfields->Jz_ )(ibin*clrw*dim1*(dim2+1)) ;
-        double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   *dim2) : &(*EMfields->rho_)(ibin*clrw* dim1   *dim2) ;
-        for ( int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[3*ipart], &(*delta)[3*ipart]);
+        for (int ipart=istart ; ipart<iend; ipart++ )
+            (*this)(b_J[0], b_J[1], b_J[2], b_J[3], particles,  ipart, (*invgf)[ipart-ipart_ref], ibin*clrw, b_dim, &(*iold)[3*(ipart-ipart_ref)], &(*delta)[3*(ipart-ipart_ref)]);
     }
-
 }
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Vectorized wrapper : same Esirkepov scheme as the main projector, with its weights factorized
+//!   Jx(i,j,k) = -crx_p * sum_{i'<i} DSx(i') * Tyz(j,k), where Tyz(j,k) = Sy0 Sz0 + DSy Sz0/2 + Sy0 DSz/2 + DSy DSz/3
+//!   (and the same for Jy and Jz by circular permutation)
+//!   - the cumulated DS and the 5x5 T factors of batch_size particles are computed together, stored by node
+//!     (CSx[i*batch_size+ipart]), in vectorized loops
+//!   - each particle then adds the products of its factors directly to the arrays, along contiguous rows in z
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D2Order::vectorized(ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref)
+{
+    int* iold = smpi->dynamics_iold[ithread].data();
+    double* deltaold = smpi->dynamics_deltaold[ithread].data();
+    
+    // Densities of the bin (rho only if diag_flag)
+    field_real* b_J[4];
+    bin_densities(EMfields, smpi, ithread, ibin, clrw, diag_flag, b_dim, ispec, b_J);
+    field_real* Jx  = b_J[0];
+    field_real* Jy  = b_J[1];
+    field_real* Jz  = b_J[2];
+    field_real* rho = b_J[3];
+    
+    double* position[3];
+    for (int idim=0 ; idim<3 ; idim++)
+        position[idim] = &( particles.position(idim, 0) );
+    particle_real* weight = &( particles.weight(0) );
+    short* charge = &( particles.charge(0) );
+    double inv_cell[3] = { dx_inv_, dy_inv_, dz_inv_ };
+    double cell_ov_dt[3] = { dx_ov_dt, dy_ov_dt, dz_ov_dt };
+    int domain_begin[3] = { i_domain_begin, j_domain_begin, k_domain_begin };
+    
+    // Coefficients along x, y and z, stored by node (S0, S1 and DS, then the cumulated DS times the current factor)
+    double S0[3][5*batch_size], S1[3][5*batch_size], DS[3][5*batch_size], CS[3][5*batch_size];
+    double charge_weight[batch_size];
+    // T factors of Jx (nodes (j,k)), Jy (nodes (i,k)) and Jz (nodes (i,j))
+    double T[3][25*batch_size];
+    // Primal indices at the current timestep, then first node of the stencils (relative to the bin)
+    int ipc[3][batch_size], ipo[3][batch_size];
+    
+    int dim_Jx[2] = { (int)(b_dim[2]*b_dim[1]),     (int) b_dim[2]    };
+    int dim_Jy[2] = { (int)(b_dim[2]*(b_dim[1]+1)), (int) b_dim[2]    };
+    int dim_Jz[2] = { (int)((b_dim[2]+1)*b_dim[1]), (int)(b_dim[2]+1) };
+    
+    for (int ibatch=istart ; ibatch<iend ; ibatch+=batch_size) {
+        int n = min( batch_size, iend-ibatch );
+        
+        #pragma omp simd
+        for (int ipart=0 ; ipart<n ; ipart++)
+            charge_weight[ipart] = (double)(charge[ibatch+ipart])*weight[ibatch+ipart];
+        
+        // --------------------------------------------------------
+        // Calculate Esirkepov coef. S0, S1 and DS
+        // --------------------------------------------------------
+        for (int idim=0 ; idim<3 ; idim++) {
+            
+            // locate the particles on the primal grid at current time-step
+            #pragma omp simd
+            for (int ipart=0 ; ipart<n ; ipart++)
+                ipc[idim][ipart] = round( position[idim][ibatch+ipart] * inv_cell[idim] );
+            
+            double* s0p = S0[idim];
+            double* s1p = S1[idim];
+            double* dsp = DS[idim];
+            double* csp = CS[idim];
+            #pragma omp simd
+            for (int ipart=0 ; ipart<n ; ipart++) {
+                int ibuf = ibatch+ipart-ipart_ref;
+                
+                // former time-step
+                double delta = deltaold[3*ibuf+idim];
+                double delta2 = delta*delta;
+                s0p[              ipart] = 0.;
+                s0p[  batch_size+ipart] = 0.5 * (delta2-delta+0.25);
+                s0p[2*batch_size+ipart] = 0.75-delta2;
+                s0p[3*batch_size+ipart] = 0.5 * (delta2+delta+0.25);
+                s0p[4*batch_size+ipart] = 0.;
+                
+                // current time-step : the 3 non-zero coefficients are shifted by ip-ipo (-1, 0 or 1)
+                int ip_m_ipo = ipc[idim][ipart]-iold[3*ibuf+idim]-domain_begin[idim];
+                delta  = position[idim][ibatch+ipart] * inv_cell[idim] - (double)ipc[idim][ipart];
+                delta2 = delta*delta;
+                double c0 = 0.5 * (delta2-delta+0.25);
+                double c1 = 0.75-delta2;
+                double c2 = 0.5 * (delta2+delta+0.25);
+                double cr_p = -charge_weight[ipart]*cell_ov_dt[idim];
+                double sum_ds = 0.;
+                for (int i=0 ; i<5 ; i++) {
+                    int m = i-1-ip_m_ipo;
+                    s1p[i*batch_size+ipart] = m==0 ? c0 : ( m==1 ? c1 : ( m==2 ? c2 : 0. ) );
+                    dsp[i*batch_size+ipart] = s1p[i*batch_size+ipart] - s0p[i*batch_size+ipart];
+                    csp[i*batch_size+ipart] = cr_p * sum_ds;
+                    sum_ds += dsp[i*batch_size+ipart];
+                }
+                
+                //This minus 2 come from the order 2 scheme, based on a 5 points stencil from -2 to +2.
+                ipo[idim][ipart] = iold[3*ibuf+idim] - 2 - ( idim==0 ? ibin*clrw : 0 );
+            }
+        }
+        
+        // T factors of the currents along each dimension, from the two other dimensions (a,b)
+        for (int idim=0 ; idim<3 ; idim++) {
+            int a = idim==0 ? 1 : 0;
+            int b = idim==2 ? 1 : 2;
+            double *Sa0 = S0[a], *Sb0 = S0[b], *DSa = DS[a], *DSb = DS[b];
+            double* Tp = T[idim];
+            for (int ia=0 ; ia<5 ; ia++) {
+                for (int ib=0 ; ib<5 ; ib++) {
+                    int iab = ia*5+ib;
+                    #pragma omp simd
+                    for (int ipart=0 ; ipart<n ; ipart++) {
+                        int ja = ia*batch_size+ipart, jb = ib*batch_size+ipart;
+                        Tp[iab*batch_size+ipart] = Sa0[ja]*Sb0[jb] + 0.5*DSa[ja]*Sb0[jb] + 0.5*Sa0[ja]*DSb[jb] + one_third*DSa[ja]*DSb[jb];
+                    }
+                }
+            }
+        }
+        
+        // ------------------------------------------------
+        // Add the currents of each particle to the arrays
+        // (Jx is null on its first node along x, and so on)
+        // ------------------------------------------------
+        for (int ipart=0 ; ipart<n ; ipart++) {
+            int ipo0 = ipo[0][ipart], jpo0 = ipo[1][ipart], kpo0 = ipo[2][ipart];
+            double CSx[5], CSy[5], CSz[5], Tyz[25], Tzx[25], Txy[25];
+            for (int i=0 ; i<5 ; i++) {
+                CSx[i] = CS[0][i*batch_size+ipart];
+                CSy[i] = CS[1][i*batch_size+ipart];
+                CSz[i] = CS[2][i*batch_size+ipart];
+            }
+            for (int ij=0 ; ij<25 ; ij++) {
+                Tyz[ij] = T[0][ij*batch_size+ipart];
+                Tzx[ij] = T[1][ij*batch_size+ipart];
+                Txy[ij] = T[2][ij*batch_size+ipart];
+            }
+            for (int i=0 ; i<5 ; i++) {
+                for (int j=0 ; j<5 ; j++) {
+                    field_real* Jx_row = &Jx[(i+ipo0)*dim_Jx[0] + (j+jpo0)*dim_Jx[1] + kpo0];
+                    field_real* Jy_row = &Jy[(i+ipo0)*dim_Jy[0] + (j+jpo0)*dim_Jy[1] + kpo0];
+                    field_real* Jz_row = &Jz[(i+ipo0)*dim_Jz[0] + (j+jpo0)*dim_Jz[1] + kpo0];
+                    double Jz_ij = Txy[i*5+j];
+                    #pragma omp simd
+                    for (int k=0 ; k<5 ; k++) {
+                        Jx_row[k] += CSx[i] * Tyz[j*5+k];
+                        Jy_row[k] += CSy[j] * Tzx[i*5+k];
+                        Jz_row[k] += Jz_ij  * CSz[k];
+                    }
+                }
+            }
+            if (rho) {
+                for (int i=0 ; i<5 ; i++) {
+                    for (int j=0 ; j<5 ; j++) {
+                        field_real* rho_row = &rho[(i+ipo0)*dim_Jx[0] + (j+jpo0)*dim_Jx[1] + kpo0];
+                        double rho_ij = charge_weight[ipart] * S1[0][i*batch_size+ipart] * S1[1][j*batch_size+ipart];
+                        #pragma omp simd
+                        for (int k=0 ; k<5 ; k++)
+                            rho_row[k] += rho_ij * S1[2][k*batch_size+ipart];
+                    }
+                }
+            }
+        }
+    }
+    
+} // END vectorized
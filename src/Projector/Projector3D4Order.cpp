@@ -0,0 +1,477 @@
+#include "Projector3D4Order.h"
+
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+#include "Particles.h"
+#include "Tools.h"
+#include "Patch.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Constructor for Projector3D4Order
+// ---------------------------------------------------------------------------------------------------------------------
+Projector3D4Order::Projector3D4Order (Params& params, Patch* patch) : Projector3D(params, patch)
+{
+    dx_inv_   = 1.0/params.cell_length[0];
+    dx_ov_dt  = params.cell_length[0] / params.timestep;
+    dy_inv_   = 1.0/params.cell_length[1];
+    dy_ov_dt  = params.cell_length[1] / params.timestep;
+    dz_inv_   = 1.0/params.cell_length[2];
+    dz_ov_dt  = params.cell_length[2] / params.timestep;
+
+    one_third = 1.0/3.0;
+
+    i_domain_begin = patch->getCellStartingGlobalIndex(0);
+    j_domain_begin = patch->getCellStartingGlobalIndex(1);
+    k_domain_begin = patch->getCellStartingGlobalIndex(2);
+
+    DEBUG("cell_length "<< params.cell_length[0]);
+
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Destructor for Projector3D4Order
+// ---------------------------------------------------------------------------------------------------------------------
+Projector3D4Order::~Projector3D4Order()
+{
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project local current densities, and the charge density if rho != NULL (sort)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D4Order::operator() (field_real* Jx, field_real* Jy, field_real* Jz, field_real* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+{
+
+    // -------------------------------------
+    // Variable declaration & initialization
+    // -------------------------------------
+
+    // (x,y,z) components of the current density for the macro-particle
+    double charge_weight = (double)(particles.charge(ipart))*particles.weight(ipart);
+    double crx_p = charge_weight*dx_ov_dt;
+    double cry_p = charge_weight*dy_ov_dt;
+    double crz_p = charge_weight*dz_ov_dt;
+
+    // variable declaration
+    double xpn, ypn, zpn;
+    // arrays used for the Esirkepov projection method (the 5 nodes of the shape function may move by one cell)
+    double Sx0[7], Sx1[7], Sy0[7], Sy1[7], Sz0[7], Sz1[7], DSx[7], DSy[7], DSz[7];
+    double Jx_p[7][7][7], Jy_p[7][7][7], Jz_p[7][7][7];
+
+    for (unsigned int i=0; i<7; i++) {
+        Sx0[i] = 0.;
+        Sy0[i] = 0.;
+        Sz0[i] = 0.;
+        Sx1[i] = 0.;
+        Sy1[i] = 0.;
+        Sz1[i] = 0.;
+    }
+
+    // --------------------------------------------------------
+    // Locate particles & Calculate Esirkepov coef. S, DS and W
+    // --------------------------------------------------------
+
+    // locate the particle on the primal grid at former time-step & calculate coeff. S0
+    ShapeFunction::quartic( *deltaold    , &Sx0[1], 1 );
+    ShapeFunction::quartic( *(deltaold+1), &Sy0[1], 1 );
+    ShapeFunction::quartic( *(deltaold+2), &Sz0[1], 1 );
+
+    // locate the particle on the primal grid at current time-step & calculate coeff. S1
+    xpn = particles.position(0, ipart) * dx_inv_;
+    int ip = round(xpn);
+    int ipo = *iold;
+    int ip_m_ipo = ip-ipo-i_domain_begin;
+    ShapeFunction::quartic( xpn - (double)ip, &Sx1[ip_m_ipo+1], 1 );
+
+    ypn = particles.position(1, ipart) * dy_inv_;
+    int jp = round(ypn);
+    int jpo = *(iold+1);
+    int jp_m_jpo = jp-jpo-j_domain_begin;
+    ShapeFunction::quartic( ypn - (double)jp, &Sy1[jp_m_jpo+1], 1 );
+
+    zpn = particles.position(2, ipart) * dz_inv_;
+    int kp = round(zpn);
+    int kpo = *(iold+2);
+    int kp_m_kpo = kp-kpo-k_domain_begin;
+    ShapeFunction::quartic( zpn - (double)kp, &Sz1[kp_m_kpo+1], 1 );
+
+    // computes Esirkepov coefficients
+    for (unsigned int i=0; i < 7; i++) {
+        DSx[i] = Sx1[i] - Sx0[i];
+        DSy[i] = Sy1[i] - Sy0[i];
+        DSz[i] = Sz1[i] - Sz0[i];
+    }
+
+    // ------------------------------------------------
+    // Local current created by the particle
+    // calculate using the charge conservation equation
+    // ------------------------------------------------
+    for (unsigned int j=0 ; j<7 ; j++)
+        for (unsigned int k=0 ; k<7 ; k++)
+            Jx_p[0][j][k] = 0.;
+    for (unsigned int i=1 ; i<7 ; i++) {
+        for (unsigned int j=0 ; j<7 ; j++) {
+            for (unsigned int k=0 ; k<7 ; k++) {
+                double Wx = DSx[i-1] * (Sy0[j]*Sz0[k] + 0.5*DSy[j]*Sz0[k] + 0.5*DSz[k]*Sy0[j] + one_third*DSy[j]*DSz[k]);
+                Jx_p[i][j][k] = Jx_p[i-1][j][k] - crx_p * Wx;
+            }
+        }
+    }
+    for (unsigned int i=0 ; i<7 ; i++) {
+        for (unsigned int k=0 ; k<7 ; k++)
+            Jy_p[i][0][k] = 0.;
+        for (unsigned int j=1 ; j<7 ; j++) {
+            for (unsigned int k=0 ; k<7 ; k++) {
+                double Wy = DSy[j-1] * (Sz0[k]*Sx0[i] + 0.5*DSz[k]*Sx0[i] + 0.5*DSx[i]*Sz0[k] + one_third*DSz[k]*DSx[i]);
+                Jy_p[i][j][k] = Jy_p[i][j-1][k] - cry_p * Wy;
+            }
+        }
+    }
+    for (unsigned int i=0 ; i<7 ; i++) {
+        for (unsigned int j=0 ; j<7 ; j++) {
+            Jz_p[i][j][0] = 0.;
+            for (unsigned int k=1 ; k<7 ; k++) {
+                double Wz = DSz[k-1] * (Sx0[i]*Sy0[j] + 0.5*DSx[i]*Sy0[j] + 0.5*DSy[j]*Sx0[i] + one_third*DSx[i]*DSy[j]);
+                Jz_p[i][j][k] = Jz_p[i][j][k-1] - crz_p * Wz;
+            }
+        }
+    }
+
+    // ---------------------------
+    // Calculate the total current
+    // ---------------------------
+
+    ipo -= bin+3;   //This minus 3 come from the order 4 scheme, based on a 7 points stencil from -3 to +3.
+                    // i/j/kpo stored with - i/j/k_domain_begin in Interpolator
+    jpo -= 3;
+    kpo -= 3;
+
+    int iloc, jloc, kloc;
+
+    for (unsigned int i=0 ; i<7 ; i++) {
+        iloc = i+ipo;
+        for (unsigned int j=0 ; j<7 ; j++) {
+            jloc = j+jpo;
+            for (unsigned int k=0 ; k<7 ; k++) {
+                kloc = k+kpo;
+                // Jx^(d,p,p)
+                Jx[iloc*b_dim[2]*b_dim[1]    +jloc*b_dim[2]    +kloc] += Jx_p[i][j][k];
+                // Jy^(p,d,p)
+                Jy[iloc*b_dim[2]*(b_dim[1]+1)+jloc*b_dim[2]    +kloc] += Jy_p[i][j][k];
+                // Jz^(p,p,d)
+                Jz[iloc*(b_dim[2]+1)*b_dim[1]+jloc*(b_dim[2]+1)+kloc] += Jz_p[i][j][k];
+            }
+        }
+    }//i
+
+    // Rho^(p,p,p)
+    if (rho) {
+        for (unsigned int i=0 ; i<7 ; i++) {
+            iloc = i+ipo;
+            for (unsigned int j=0 ; j<7 ; j++) {
+                jloc = j+jpo;
+                for (unsigned int k=0 ; k<7 ; k++) {
+                    kloc = k+kpo;
+                    rho[iloc*b_dim[2]*b_dim[1]+jloc*b_dim[2]+kloc] += charge_weight * Sx1[i]*Sy1[j]*Sz1[k];
+                }
+            }
+        }//i
+    }
+
+} // END Project local densities (Jx, Jy, Jz, rho, sort)
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project local densities only (Frozen species)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D4Order::operator() (field_real* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim)
+{
+    //Warning : this function is used for frozen species only. It is assumed that position = position_old !!!
+
+    // -------------------------------------
+    // Variable declaration & initialization
+    // -------------------------------------
+
+    int iloc,jloc;
+    // (x,y,z) components of the current density for the macro-particle
+    double charge_weight = (double)(particles.charge(ipart))*particles.weight(ipart);
+
+    // variable declaration
+    double xpn, ypn, zpn;
+    double Sx1[5], Sy1[5], Sz1[5];
+
+    // locate the particle on the primal grid at current time-step & calculate coeff. S1
+    xpn = particles.position(0, ipart) * dx_inv_;
+    int ip = round(xpn);
+    ShapeFunction::quartic( xpn - (double)ip, Sx1, 1 );
+
+    ypn = particles.position(1, ipart) * dy_inv_;
+    int jp = round(ypn);
+    ShapeFunction::quartic( ypn - (double)jp, Sy1, 1 );
+
+    zpn = particles.position(2, ipart) * dz_inv_;
+    int kp = round(zpn);
+    ShapeFunction::quartic( zpn - (double)kp, Sz1, 1 );
+
+    // ---------------------------
+    // Calculate the total charge
+    // ---------------------------
+    ip -= i_domain_begin + bin +2;
+    jp -= j_domain_begin + 2;
+    kp -= k_domain_begin + 2;
+
+    for (unsigned int i=0 ; i<5 ; i++) {
+        iloc = (i+ip)*b_dim[2]*b_dim[1];
+        for (unsigned int j=0 ; j<5 ; j++) {
+            jloc = (jp+j)*b_dim[2];
+            for (unsigned int k=0 ; k<5 ; k++) {
+                rho[iloc+jloc+kp+k] += charge_weight * Sx1[i]*Sy1[j]*Sz1[k];
+            }
+        }
+    }//i
+
+} // END Project local current densities (Frozen species)
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project global current densities (ionize)
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D4Order::operator() (Field* Jx, Field* Jy, Field* Jz, Particles &particles, int ipart, LocalFields Jion)
+{
+    Field3D* Jx3D  = static_cast<Field3D*>(Jx);
+    Field3D* Jy3D  = static_cast<Field3D*>(Jy);
+    Field3D* Jz3D  = static_cast<Field3D*>(Jz);
+
+    double Sxp[5], Sxd[5], Syp[5], Syd[5], Szp[5], Szd[5];
+
+    // weighted currents
+    double Jx_ion = Jion.x * particles.weight(ipart);
+    double Jy_ion = Jion.y * particles.weight(ipart);
+    double Jz_ion = Jion.z * particles.weight(ipart);
+
+    //Locate particle on the grid
+    double xpn = particles.position(0, ipart) * dx_inv_;  // normalized distance to the first node
+    double ypn = particles.position(1, ipart) * dy_inv_;  // normalized distance to the first node
+    double zpn = particles.position(2, ipart) * dz_inv_;  // normalized distance to the first node
+
+    // primal and dual indices of the central nodes, and coefficients
+    int ip = round(xpn);
+    int id = round(xpn+0.5);
+    int jp = round(ypn);
+    int jd = round(ypn+0.5);
+    int kp = round(zpn);
+    int kd = round(zpn+0.5);
+    ShapeFunction::quartic( xpn - (double)ip      , Sxp, 1 );
+    ShapeFunction::quartic( xpn - (double)id + 0.5, Sxd, 1 );
+    ShapeFunction::quartic( ypn - (double)jp      , Syp, 1 );
+    ShapeFunction::quartic( ypn - (double)jd + 0.5, Syd, 1 );
+    ShapeFunction::quartic( zpn - (double)kp      , Szp, 1 );
+    ShapeFunction::quartic( zpn - (double)kd + 0.5, Szd, 1 );
+
+    ip  -= i_domain_begin;
+    id  -= i_domain_begin;
+    jp  -= j_domain_begin;
+    jd  -= j_domain_begin;
+    kp  -= k_domain_begin;
+    kd  -= k_domain_begin;
+
+    for (unsigned int i=0 ; i<5 ; i++) {
+        int iploc=ip+i-2;
+        int idloc=id+i-2;
+        for (unsigned int j=0 ; j<5 ; j++) {
+            int jploc=jp+j-2;
+            int jdloc=jd+j-2;
+            for (unsigned int k=0 ; k<5 ; k++) {
+                int kploc=kp+k-2;
+                int kdloc=kd+k-2;
+                // Jx^(d,p,p)
+                (*Jx3D)(idloc,jploc,kploc) += Jx_ion * Sxd[i]*Syp[j]*Szp[k];
+                // Jy^(p,d,p)
+                (*Jy3D)(iploc,jdloc,kploc) += Jy_ion * Sxp[i]*Syd[j]*Szp[k];
+                // Jz^(p,p,d)
+                (*Jz3D)(iploc,jploc,kdloc) += Jz_ion * Sxp[i]*Syp[j]*Szd[k];
+            }//k
+        }//j
+    }//i
+
+} // END Project global current densities (ionize)
+
+//Wrapper for projection
+void Projector3D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref)
+{
+    std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
+    std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
+    std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
+
+    // Densities of the bin (rho only if diag_flag), in the patch arrays or in the thread's tiles
+    field_real* b_J[4];
+    bin_densities(EMfields, smpi, ithread, ibin, clrw, diag_flag, b_dim, ispec, b_J);
+
+    for (int ipart=istart ; ipart<iend; ipart++ )
+        (*this)(b_J[0], b_J[1], b_J[2], b_J[3], particles,  ipart, (*invgf)[ipart-ipart_ref], ibin*clrw, b_dim, &(*iold)[3*(ipart-ipart_ref)], &(*delta)[3*(ipart-ipart_ref)]);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Vectorized wrapper : same Esirkepov scheme as the main projector, with its weights factorized as in
+//! Projector3D2Order::vectorized (Jx(i,j,k) = -crx_p * sum_{i'<i} DSx(i') * Tyz(j,k), on 7 nodes per dimension)
+//!   - the cumulated DS and the 7x7 T factors of batch_size particles are computed together, stored by node
+//!   - each particle then adds the products of its factors directly to the arrays, along contiguous rows in z
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D4Order::vectorized(ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref)
+{
+    int* iold = smpi->dynamics_iold[ithread].data();
+    double* deltaold = smpi->dynamics_deltaold[ithread].data();
+
+    // Densities of the bin (rho only if diag_flag)
+    field_real* b_J[4];
+    bin_densities(EMfields, smpi, ithread, ibin, clrw, diag_flag, b_dim, ispec, b_J);
+    field_real* Jx  = b_J[0];
+    field_real* Jy  = b_J[1];
+    field_real* Jz  = b_J[2];
+    field_real* rho = b_J[3];
+
+    double* position[3];
+    for (int idim=0 ; idim<3 ; idim++)
+        position[idim] = &( particles.position(idim, 0) );
+    particle_real* weight = &( particles.weight(0) );
+    short* charge = &( particles.charge(0) );
+    double inv_cell[3] = { dx_inv_, dy_inv_, dz_inv_ };
+    double cell_ov_dt[3] = { dx_ov_dt, dy_ov_dt, dz_ov_dt };
+    int domain_begin[3] = { i_domain_begin, j_domain_begin, k_domain_begin };
+
+    // Coefficients along x, y and z, stored by node (S0, S1 and DS, then the cumulated DS times the current factor)
+    double S0[3][7*batch_size], S1[3][7*batch_size], DS[3][7*batch_size], CS[3][7*batch_size];
+    double charge_weight[batch_size];
+    // T factors of Jx (nodes (j,k)), Jy (nodes (i,k)) and Jz (nodes (i,j))
+    double T[3][49*batch_size];
+    // Primal indices at the current timestep, then first node of the stencils (relative to the bin)
+    int ipc[3][batch_size], ipo[3][batch_size];
+
+    int dim_Jx[2] = { (int)(b_dim[2]*b_dim[1]),     (int) b_dim[2]    };
+    int dim_Jy[2] = { (int)(b_dim[2]*(b_dim[1]+1)), (int) b_dim[2]    };
+    int dim_Jz[2] = { (int)((b_dim[2]+1)*b_dim[1]), (int)(b_dim[2]+1) };
+
+    for (int ibatch=istart ; ibatch<iend ; ibatch+=batch_size) {
+        int n = min( batch_size, iend-ibatch );
+
+        #pragma omp simd
+        for (int ipart=0 ; ipart<n ; ipart++)
+            charge_weight[ipart] = (double)(charge[ibatch+ipart])*weight[ibatch+ipart];
+
+        // --------------------------------------------------------
+        // Calculate Esirkepov coef. S0, S1 and DS
+        // --------------------------------------------------------
+        for (int idim=0 ; idim<3 ; idim++) {
+
+            // locate the particles on the primal grid at current time-step
+            #pragma omp simd
+            for (int ipart=0 ; ipart<n ; ipart++)
+                ipc[idim][ipart] = round( position[idim][ibatch+ipart] * inv_cell[idim] );
+
+            double* s0p = S0[idim];
+            double* s1p = S1[idim];
+            double* dsp = DS[idim];
+            double* csp = CS[idim];
+            #pragma omp simd
+            for (int ipart=0 ; ipart<n ; ipart++) {
+                int ibuf = ibatch+ipart-ipart_ref;
+
+                // former time-step
+                s0p[ipart] = 0.;
+                ShapeFunction::quartic( deltaold[3*ibuf+idim], &s0p[batch_size+ipart], batch_size );
+                s0p[6*batch_size+ipart] = 0.;
+
+                // current time-step : the 5 non-zero coefficients are shifted by ip-ipo (-1, 0 or 1)
+                int ip_m_ipo = ipc[idim][ipart]-iold[3*ibuf+idim]-domain_begin[idim];
+                double c[5];
+                ShapeFunction::quartic( position[idim][ibatch+ipart] * inv_cell[idim] - (double)ipc[idim][ipart], c, 1 );
+                double cr_p = -charge_weight[ipart]*cell_ov_dt[idim];
+                double sum_ds = 0.;
+                for (int i=0 ; i<7 ; i++) {
+                    int m = i-1-ip_m_ipo;
+                    double s1 = 0.;
+                    for (int l=0 ; l<5 ; l++)
+                        s1 = m==l ? c[l] : s1;
+                    s1p[i*batch_size+ipart] = s1;
+                    dsp[i*batch_size+ipart] = s1 - s0p[i*batch_size+ipart];
+                    csp[i*batch_size+ipart] = cr_p * sum_ds;
+                    sum_ds += dsp[i*batch_size+ipart];
+                }
+
+                //This minus 3 come from the order 4 scheme, based on a 7 points stencil from -3 to +3.
+                ipo[idim][ipart] = iold[3*ibuf+idim] - 3 - ( idim==0 ? ibin*clrw : 0 );
+            }
+        }
+
+        // T factors of the currents along each dimension, from the two other dimensions (a,b)
+        for (int idim=0 ; idim<3 ; idim++) {
+            int a = idim==0 ? 1 : 0;
+            int b = idim==2 ? 1 : 2;
+            double *Sa0 = S0[a], *Sb0 = S0[b], *DSa = DS[a], *DSb = DS[b];
+            double* Tp = T[idim];
+            for (int ia=0 ; ia<7 ; ia++) {
+                for (int ib=0 ; ib<7 ; ib++) {
+                    int iab = ia*7+ib;
+                    #pragma omp simd
+                    for (int ipart=0 ; ipart<n ; ipart++) {
+                        int ja = ia*batch_size+ipart, jb = ib*batch_size+ipart;
+                        Tp[iab*batch_size+ipart] = Sa0[ja]*Sb0[jb] + 0.5*DSa[ja]*Sb0[jb] + 0.5*Sa0[ja]*DSb[jb] + one_third*DSa[ja]*DSb[jb];
+                    }
+                }
+            }
+        }
+
+        // ------------------------------------------------
+        // Add the currents of each particle to the arrays
+        // (Jx is null on its first node along x, and so on)
+        // ------------------------------------------------
+        for (int ipart=0 ; ipart<n ; ipart++) {
+            int ipo0 = ipo[0][ipart], jpo0 = ipo[1][ipart], kpo0 = ipo[2][ipart];
+            double CSx[7], CSy[7], CSz[7], Tyz[49], Tzx[49], Txy[49];
+            for (int i=0 ; i<7 ; i++) {
+                CSx[i] = CS[0][i*batch_size+ipart];
+                CSy[i] = CS[1][i*batch_size+ipart];
+                CSz[i] = CS[2][i*batch_size+ipart];
+            }
+            for (int ij=0 ; ij<49 ; ij++) {
+                Tyz[ij] = T[0][ij*batch_size+ipart];
+                Tzx[ij] = T[1][ij*batch_size+ipart];
+                Txy[ij] = T[2][ij*batch_size+ipart];
+            }
+            for (int i=0 ; i<7 ; i++) {
+                for (int j=0 ; j<7 ; j++) {
+                    field_real* Jx_row = &Jx[(i+ipo0)*dim_Jx[0] + (j+jpo0)*dim_Jx[1] + kpo0];
+                    field_real* Jy_row = &Jy[(i+ipo0)*dim_Jy[0] + (j+jpo0)*dim_Jy[1] + kpo0];
+                    field_real* Jz_row = &Jz[(i+ipo0)*dim_Jz[0] + (j+jpo0)*dim_Jz[1] + kpo0];
+                    double Jz_ij = Txy[i*7+j];
+                    #pragma omp simd
+                    for (int k=0 ; k<7 ; k++) {
+                        Jx_row[k] += CSx[i] * Tyz[j*7+k];
+                        Jy_row[k] += CSy[j] * Tzx[i*7+k];
+                        Jz_row[k] += Jz_ij  * CSz[k];
+                    }
+                }
+            }
+            if (rho) {
+                for (int i=0 ; i<7 ; i++) {
+                    for (int j=0 ; j<7 ; j++) {
+                        field_real* rho_row = &rho[(i+ipo0)*dim_Jx[0] + (j+jpo0)*dim_Jx[1] + kpo0];
+                        double rho_ij = charge_weight[ipart] * S1[0][i*batch_size+ipart] * S1[1][j*batch_size+ipart];
+                        #pragma omp simd
+                        for (int k=0 ; k<7 ; k++)
+                            rho_row[k] += rho_ij * S1[2][k*batch_size+ipart];
+                    }
+                }
+            }
+        }
+    }
+
+} // END vectorized
@@ -0,0 +1,37 @@
+#ifndef PROJECTOR3D4ORDER_H
+#define PROJECTOR3D4ORDER_H
+
+#include "Projector3D.h"
+#include "ShapeFunction.h"
+
+
+class Projector3D4Order : public Projector3D {
+public:
+    Projector3D4Order(Params&, Patch* patch);
+    ~Projector3D4Order();
+
+    //! Project global current densities (EMfields->Jx_/Jy_/Jz_), and the charge if rho != NULL (diagFields timestep)
+    inline void operator() (field_real* Jx, field_real* Jy, field_real* Jz, field_real* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold);
+
+    //! Project global current charge (EMfields->rho_), frozen & diagFields timestep
+    void operator() (field_real* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim) override final;
+
+    //! Project global current densities if Ionization in Species::dynamics,
+    void operator() (Field* Jx, Field* Jy, Field* Jz, Particles &particles, int ipart, LocalFields Jion) override final;
+
+    //!Wrapper
+    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref = 0) override final;
+
+    //! Vectorized wrapper: the factors of the Esirkepov weights of batch_size particles are computed together, then
+    //! their products are added directly to the arrays
+    void vectorized(ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref = 0) override final;
+
+    //! Number of particles whose stencils are computed together by the vectorized wrapper
+    static const int batch_size = 8;
+
+private:
+    double one_third;
+};
+
+#endif
+
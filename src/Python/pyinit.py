@@ -139,6 +139,7 @@ class Main(SmileiSingleton):
     bc_em_type_z = []
     time_fields_frozen = 0.
     currentFilter_int = 0
+    exchange_fields_each = 1
     
     # Default Misc
     referenceAngularFrequency_SI = 0.
@@ -261,6 +262,12 @@ class Species(SmileiComponent):
     track_every = 0
     track_ordered = False
     track_flush_every = 1
+    sort_mode = "bins"
+    sort_threshold = 0.
+    dynamics_block_size = 0
+    bin_tiles = False
+    projection_mode = "scalar"
+    split_patch_threshold = 0
 
 class Laser(SmileiComponent):
     """Laser parameters"""
@@ -277,6 +284,8 @@ class Collisions(SmileiComponent):
     species1 = None
     species2 = None
     coulomb_log = 0.
+    every = 1
+    adaptive_s = 0.
     debug_every = 0
     ionizing = False
 
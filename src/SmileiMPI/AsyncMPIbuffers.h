@@ -16,14 +16,15 @@ public:
 
     virtual void allocate(unsigned int nDim_field);
 
-    virtual void allocate(int nDim_field, Field* f);
+    //! Allocate the requests and the buffers of the sums of field f, whose guard cells are oversize cells wide
+    virtual void allocate(int nDim_field, Field* f, std::vector<unsigned int>& oversize);
     void defineTags(Patch* patch, int tag ) ;
     
     //! ndim vectors of 2 sent requests (1 per direction) 
     std::vector< std::vector<MPI_Request> > srequest;
     //! ndim vectors of 2 received requests (1 per direction) 
     std::vector< std::vector<MPI_Request> > rrequest;
-    std::vector< double >  buf[3][2];
+    std::vector< field_real >  buf[3][2];
 
     std::vector< std::vector<int> > send_tags_, recv_tags_;
 
@@ -126,12 +126,22 @@ void SmileiMPI::init( Params& params )
     dynamics_invgf.resize(omp_get_max_threads());
     dynamics_iold.resize(omp_get_max_threads());
     dynamics_deltaold.resize(omp_get_max_threads());
+    dynamics_EBtile.resize(omp_get_max_threads());
+    dynamics_EBtile_start.resize(omp_get_max_threads(), -1);
+    dynamics_Jtile.resize(omp_get_max_threads());
+    dynamics_Jtile_bin.resize(omp_get_max_threads(), -1);
+    dynamics_Jthread.resize(omp_get_max_threads());
 #else
     dynamics_Epart.resize(1);
     dynamics_Bpart.resize(1);
     dynamics_invgf.resize(1);
     dynamics_iold.resize(1);
     dynamics_deltaold.resize(1);
+    dynamics_EBtile.resize(1);
+    dynamics_EBtile_start.resize(1, -1);
+    dynamics_Jtile.resize(1);
+    dynamics_Jtile_bin.resize(1, -1);
+    dynamics_Jthread.resize(1);
 #endif
 
     // Set periodicity of the simulated problem
@@ -516,15 +526,21 @@ int SmileiMPI::hrank(int h)
 // ----------------------------------------------------------------------
 MPI_Datatype SmileiMPI::createMPIparticles( Particles* particles )
 {
-    int nbrOfProp = particles->double_prop.size() + particles->short_prop.size() + particles->uint_prop.size();
+    // Properties are ordered by type : double, particle_real, short, unsigned int
+    int offset_real_prop  = particles->double_prop.size();
+    int offset_short_prop = offset_real_prop  + particles->real_prop.size();
+    int offset_uint_prop  = offset_short_prop + particles->short_prop.size();
+    int nbrOfProp         = offset_uint_prop  + particles->uint_prop.size();
 
     MPI_Aint address[nbrOfProp];
     for ( unsigned int iprop=0 ; iprop<particles->double_prop.size() ; iprop++ )
         MPI_Get_address( &( (*(particles->double_prop[iprop]))[0] ), &(address[iprop]) );
+    for ( unsigned int iprop=0 ; iprop<particles->real_prop.size() ; iprop++ )
+        MPI_Get_address( &( (*(particles->real_prop[iprop]))[0] ), &(address[offset_real_prop+iprop]) );
     for ( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->short_prop[iprop]))[0] ), &(address[particles->double_prop.size()+iprop]) );
+        MPI_Get_address( &( (*(particles->short_prop[iprop]))[0] ), &(address[offset_short_prop+iprop]) );
     for ( unsigned int iprop=0 ; iprop<particles->uint_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->uint_prop[iprop]))[0] ), &(address[particles->double_prop.size()+particles->short_prop.size()+iprop]) );
+        MPI_Get_address( &( (*(particles->uint_prop[iprop]))[0] ), &(address[offset_uint_prop+iprop]) );
 
     int nbr_parts[nbrOfProp];
     // number of elements per property
@@ -541,10 +557,16 @@ MPI_Datatype SmileiMPI::createMPIparticles( Particles* particles )
     // define MPI type of each property, default is DOUBLE
     for ( unsigned int i=0 ; i<particles->double_prop.size() ; i++)
         partDataType[i] = MPI_DOUBLE;
+    for ( unsigned int iprop=0 ; iprop<particles->real_prop.size() ; iprop++ )
+#ifdef __SINGLE_PARTICLES
+        partDataType[ offset_real_prop+iprop] = MPI_FLOAT;
+#else
+        partDataType[ offset_real_prop+iprop] = MPI_DOUBLE;
+#endif
     for ( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ )
-        partDataType[ particles->double_prop.size()+iprop] = MPI_SHORT;
+        partDataType[ offset_short_prop+iprop] = MPI_SHORT;
     for ( unsigned int iprop=0 ; iprop<particles->uint_prop.size() ; iprop++ )
-        partDataType[ particles->double_prop.size()+particles->short_prop.size()+iprop] = MPI_UNSIGNED;
+        partDataType[ offset_uint_prop+iprop] = MPI_UNSIGNED;
 
     MPI_Datatype typeParticlesMPI;
     MPI_Type_create_struct( nbrOfProp, &(nbr_parts[0]), &(disp[0]), &(partDataType[0]), &typeParticlesMPI);
@@ -572,6 +594,10 @@ void SmileiMPI::isend(Patch* patch, int to, int tag, Params& params)
             MPI_Type_free( &(patch->vecSpecies[ispec]->typePartSend) );
         }
     }
+    
+    // Send the state of the adaptive collisions
+    for (unsigned int icoll=0 ; icoll<patch->vecCollisions.size() ; icoll++)
+        patch->vecCollisions[icoll]->isendInterval( to, tag+2*patch->vecSpecies.size()+icoll );
 
     //! \todo Removed the following block because the probe particles are not exchanged
     //
@@ -581,7 +607,7 @@ void SmileiMPI::isend(Patch* patch, int to, int tag, Params& params)
     //}
 
     // Count number max of comms :
-    int maxtag = 2 * patch->vecSpecies.size() + (2+params.nDim_particle) * patch->probes.size();
+    int maxtag = 2 * patch->vecSpecies.size() + patch->vecCollisions.size() + (2+params.nDim_particle) * patch->probes.size();
     
     isend( patch->EMfields, to, maxtag );
     
@@ -610,6 +636,10 @@ void SmileiMPI::recv(Patch* patch, int from, int tag, Params& params)
         }
     }
     
+    // Receive the state of the adaptive collisions
+    for (unsigned int icoll=0 ; icoll<patch->vecCollisions.size() ; icoll++)
+        patch->vecCollisions[icoll]->recvInterval( from, tag+2*patch->vecSpecies.size()+icoll );
+    
     // Removed next block because the probe particles are not exchanged.
     //
     //// Receive probes' particles
@@ -618,7 +648,7 @@ void SmileiMPI::recv(Patch* patch, int from, int tag, Params& params)
     //}
 
     // Count number max of comms :
-    int maxtag = 2 * patch->vecSpecies.size() + (2+params.nDim_particle) * patch->probes.size();
+    int maxtag = 2 * patch->vecSpecies.size() + patch->vecCollisions.size() + (2+params.nDim_particle) * patch->probes.size();
 
     patch->EMfields->initAntennas(patch);
     recv( patch->EMfields, from, maxtag );
@@ -836,7 +866,7 @@ void SmileiMPI::recv(ElectroMagn* EM, int from, int tag)
 void SmileiMPI::isend(Field* field, int to, int hindex)
 {
     MPI_Request request;
-    MPI_Isend( &((*field)(0)),field->globalDims_, MPI_DOUBLE, to, hindex, MPI_COMM_WORLD, &request );
+    MPI_Isend( &((*field)(0)),field->globalDims_, MPI_FIELD_REAL, to, hindex, MPI_COMM_WORLD, &request );
 
 } // End isend ( Field )
 
@@ -844,7 +874,7 @@ void SmileiMPI::isend(Field* field, int to, int hindex)
 void SmileiMPI::recv(Field* field, int from, int hindex)
 {
     MPI_Status status;
-    MPI_Recv( &((*field)(0)),field->globalDims_, MPI_DOUBLE, from, hindex, MPI_COMM_WORLD, &status );
+    MPI_Recv( &((*field)(0)),field->globalDims_, MPI_FIELD_REAL, from, hindex, MPI_COMM_WORLD, &status );
 
 } // End recv ( Field )
 
@@ -10,6 +10,7 @@
 #include "Tools.h"
 #include "Particles.h"
 #include "Field.h"
+#include "AlignedAllocator.h"
 
 class Params;
 class Species;
@@ -121,21 +122,34 @@ public:
     // Global buffers for vectorization of Species::dynamics
     // -----------------------------------------------------
     
-    //! value of the Efield 
-    std::vector<std::vector<LocalFields>> dynamics_Epart;
-    //! value of the Bfield
-    std::vector<std::vector<LocalFields>> dynamics_Bpart;
+    //! value of the Efield, stored by component (Ex of all particles, then Ey, then Ez), each component being aligned
+    std::vector<std::vector<double, AlignedAllocator<double> > > dynamics_Epart;
+    //! value of the Bfield, same layout as dynamics_Epart
+    std::vector<std::vector<double, AlignedAllocator<double> > > dynamics_Bpart;
     //! gamma factor
     std::vector<std::vector<double>> dynamics_invgf;
     //! iold_pos
     std::vector<std::vector<int>> dynamics_iold;
     //! delta_old_pos
     std::vector<std::vector<double>> dynamics_deltaold;
+    //! tile of the fields around one bin, the six components of E and B being interleaved node by node
+    std::vector<std::vector<field_real>> dynamics_EBtile;
+    //! first row (patch index along x) of dynamics_EBtile, -1 if the fields are interpolated from the patch arrays
+    std::vector<int> dynamics_EBtile_start;
+    //! tile of the densities of one bin (Jx, Jy, Jz, then rho), accumulated before being added to the patch arrays
+    std::vector<std::vector<field_real>> dynamics_Jtile;
+    //! bin accumulated in dynamics_Jtile, -1 if the densities are projected directly on the patch arrays
+    std::vector<int> dynamics_Jtile_bin;
+    //! private densities of a whole patch (Jx, Jy, Jz, then rho) when its bins are shared among threads, empty otherwise
+    std::vector<std::vector<field_real>> dynamics_Jthread;
     
     // Resize buffers for a given number of particles
     inline void dynamics_resize(int ithread, int ndim_part, int npart ){
-        dynamics_Epart[ithread].resize(npart);
-        dynamics_Bpart[ithread].resize(npart);
+        // Number of particles per field component, rounded so that each component starts on an aligned address
+        int nalign = SMILEI_ALIGNMENT/sizeof(double);
+        int nparts = ( (npart+nalign-1)/nalign ) * nalign;
+        dynamics_Epart[ithread].resize(3*nparts);
+        dynamics_Bpart[ithread].resize(3*nparts);
         dynamics_invgf[ithread].resize(npart);
         dynamics_iold[ithread].resize(ndim_part*npart);
         dynamics_deltaold[ithread].resize(ndim_part*npart);
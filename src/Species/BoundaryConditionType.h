@@ -71,6 +71,7 @@ inline int thermalize_particle( Particles &particles, int ipart, int direction,
     if ( v>3.0*species->thermalVelocity[0] ) {    //IF VELOCITY > 3*THERMAL VELOCITY THEN THERMALIZE IT
         
         // velocity of the particle after thermalization/reflection 
+        // (random draws 1 to 18 of the particle in the stream of the timestep, the draw 0 being used by the ionization)
         //for (int i=0; i<species->nDim_fields; i++) {
         for (int i=0; i<3; i++) {
             
@@ -78,13 +79,13 @@ inline int thermalize_particle( Particles &particles, int ipart, int direction,
                 // change of velocity in the direction normal to the reflection plane
                 double sign_vel = -particles.momentum(i,ipart)/std::abs(particles.momentum(i,ipart));
                 particles.momentum(i,ipart) = sign_vel * species->thermalMomentum[i]
-                *                             std::sqrt( -std::log(1.0-((double)rand() / ((double)RAND_MAX+0.1)) ) );
+                *                             std::sqrt( -std::log(1.0-species->random.uniform( ipart, 1+2*(3*direction+i) )) );
                 
             } else {
                 // change of momentum in the direction(s) along the reflection plane
-                double sign_rnd = (double)rand() / RAND_MAX - 0.5; sign_rnd = (sign_rnd)/std::abs(sign_rnd);
+                double sign_rnd = species->random.uniform( ipart, 1+2*(3*direction+i) ) < 0.5 ? -1. : 1.;
                 particles.momentum(i,ipart) = sign_rnd * species->thermalMomentum[i]
-                *                             userFunctions::erfinv( (double)rand() / ((double)RAND_MAX+0.1) );
+                *                             userFunctions::erfinv( species->random.uniform( ipart, 2+2*(3*direction+i) ) );
             }//if
             
         }//i
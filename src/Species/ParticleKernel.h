@@ -0,0 +1,110 @@
+#ifndef PARTICLEKERNEL_H
+#define PARTICLEKERNEL_H
+
+#include <vector>
+
+#include "Params.h"
+#include "Species.h"
+#include "Particles.h"
+#include "ElectroMagn.h"
+#include "Interpolator.h"
+#include "Projector.h"
+#include "Ionization.h"
+#include "PartBoundCond.h"
+#include "PartWall.h"
+#include "SmileiMPI.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class ParticleKernel: interpolation, ionization, push, boundary conditions and projection of the particles of a bin
+//  --------------------------------------------------------------------------------------------------------------------
+class ParticleKernel
+{
+
+public:
+    virtual ~ParticleKernel() {};
+
+    //! Move the particles of bin ibin of the species: the particles leaving the patch are appended to exchange_list
+    //! and the energy lost at the boundaries is added to nrj_lost
+    virtual void operator() (Species* species, unsigned int ibin, int ithread, unsigned int ispec, ElectroMagn* EMfields,
+                             Interpolator* Interp, Projector* Proj, Params &params, bool diag_flag, PartWalls* partWalls,
+                             SmileiMPI* smpi, std::vector<int> &exchange_list, double &nrj_lost) = 0;
+
+};
+
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Kernel instantiated for one interpolator, one projector and one pusher (see ParticleKernelFactory)
+//! Their methods being final, they are called directly (and may be inlined) instead of through the virtual tables
+//  --------------------------------------------------------------------------------------------------------------------
+template<class InterpType, class ProjType, class PushType>
+class ParticleKernelT final : public ParticleKernel
+{
+
+public:
+    void operator() (Species* species, unsigned int ibin, int ithread, unsigned int ispec, ElectroMagn* EMfields,
+                     Interpolator* Interp, Projector* Proj, Params &params, bool diag_flag, PartWalls* partWalls,
+                     SmileiMPI* smpi, std::vector<int> &exchange_list, double &nrj_lost) override {
+        // The factory selects the types of the operators created for the same parameters
+        InterpType* interp = static_cast<InterpType*>( Interp );
+        ProjType*   proj   = static_cast<ProjType*>  ( Proj );
+        PushType*   push   = static_cast<PushType*>  ( species->Push );
+        Particles &particles = *species->particles;
+
+        double ener_iPart(0.);
+
+        //Point to local thread dedicated buffers (fields at the particle positions, needed for ionization)
+        double* Epart = smpi->dynamics_Epart[ithread].data();
+        int nparts = smpi->dynamics_Epart[ithread].size()/3;
+
+        int bmin = species->bmin[ibin];
+        int bmax = species->bmax[ibin];
+
+        // Each stage is applied to the whole bin, or to blocks of dynamics_block_size particles
+        // which go through all the stages while they are still in cache
+        int block_size = species->dynamics_block_size>0 ? species->dynamics_block_size : std::max(bmax-bmin, 1);
+        for (int istart=bmin ; istart<bmax ; istart+=block_size) {
+            int iend = std::min( istart+block_size, bmax );
+            // Index of the particle stored first in the buffers
+            int ipart_ref = species->dynamics_block_size>0 ? istart : 0;
+
+            // Interpolate the fields at the particle position
+            (*interp)(EMfields, particles, smpi, istart, iend, ithread, ipart_ref );
+
+            // Ionization (new electrons and ionization current)
+            if (species->Ionize)
+                (*species->Ionize)(particles, istart, iend, Epart, nparts, EMfields, proj, ipart_ref);
+
+            // Push the particles
+            (*push)(particles, smpi, istart, iend, ithread, ipart_ref );
+
+            // Apply wall and boundary conditions
+            for(unsigned int iwall=0; iwall<partWalls->size(); iwall++) {
+                for (int iPart=istart ; iPart<iend; iPart++ ) {
+                    double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart-ipart_ref];
+                    if ( !(*partWalls)[iwall]->apply(particles, iPart, species, dtgf, ener_iPart)) {
+                        nrj_lost += species->mass * ener_iPart;
+                    }
+                }
+            }
+            // Boundary Condition may be physical or due to domain decomposition
+            // apply returns 0 if iPart is not in the local domain anymore
+            for (int iPart=istart ; iPart<iend; iPart++ ) {
+                if ( !species->partBoundCond->apply( particles, iPart, species, ener_iPart ) ) {
+                    exchange_list.push_back( iPart );
+                    nrj_lost += species->mass * ener_iPart;
+                }
+            }
+
+            // Project currents if not a Test species and charges as well if a diag is needed.
+            if (!particles.isTest) {
+                if (species->vectorized_projection)
+                    proj->vectorized(EMfields, particles, smpi, istart, iend, ithread, ibin, species->clrw, diag_flag, species->b_dim, ispec, ipart_ref );
+                else
+                    (*proj)(EMfields, particles, smpi, istart, iend, ithread, ibin, species->clrw, diag_flag, species->b_dim, ispec, ipart_ref );
+            }
+        }
+    };
+
+};
+
+#endif
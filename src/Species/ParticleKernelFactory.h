@@ -0,0 +1,82 @@
+#ifndef PARTICLEKERNELFACTORY_H
+#define PARTICLEKERNELFACTORY_H
+
+#include "ParticleKernel.h"
+
+#include "Interpolator1D2Order.h"
+#include "Interpolator1D4Order.h"
+#include "Interpolator2D2Order.h"
+#include "Interpolator3D2Order.h"
+#include "Interpolator3D4Order.h"
+#include "Projector1D2Order.h"
+#include "Projector1D4Order.h"
+#include "Projector2D2Order.h"
+#include "Projector3D2Order.h"
+#include "Projector3D4Order.h"
+#include "PusherBoris.h"
+#include "PusherBorisNR.h"
+#include "PusherRRLL.h"
+
+#include "Params.h"
+#include "Species.h"
+
+#include "Tools.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class ParticleKernelFactory
+//  --------------------------------------------------------------------------------------------------------------------
+class ParticleKernelFactory {
+public:
+    //  --------------------------------------------------------------------------------------------------------------------
+    //! Create the kernel matching the interpolator and projector of InterpolatorFactory and ProjectorFactory,
+    //! and the pusher of PusherFactory
+    //  --------------------------------------------------------------------------------------------------------------------
+    static ParticleKernel* create(Params& params, Species * species) {
+        ParticleKernel* Kernel = NULL;
+        // ---------------
+        // 1d3v simulation
+        // ---------------
+        if ( ( params.geometry == "1d3v" ) && ( params.interpolation_order == 2 ) ) {
+            Kernel = create<Interpolator1D2Order, Projector1D2Order, 1>( species );
+        }
+        else if ( ( params.geometry == "1d3v" ) && ( params.interpolation_order == 4 ) ) {
+            Kernel = create<Interpolator1D4Order, Projector1D4Order, 1>( species );
+        }
+        // ---------------
+        // 2d3v simulation
+        // ---------------
+        else if ( ( params.geometry == "2d3v" ) && ( params.interpolation_order == 2 ) ) {
+            Kernel = create<Interpolator2D2Order, Projector2D2Order, 2>( species );
+        }
+        // ---------------
+        // 3d3v simulation
+        // ---------------
+        else if ( ( params.geometry == "3d3v" ) && ( params.interpolation_order == 2 ) ) {
+            Kernel = create<Interpolator3D2Order, Projector3D2Order, 3>( species );
+        }
+        else if ( ( params.geometry == "3d3v" ) && ( params.interpolation_order == 4 ) ) {
+            Kernel = create<Interpolator3D4Order, Projector3D4Order, 3>( species );
+        }
+        else {
+            ERROR( "Unknwon parameters : " << params.geometry << ", Order : " << params.interpolation_order );
+        }
+
+        return Kernel;
+    }
+
+    //  --------------------------------------------------------------------------------------------------------------------
+    //! Create the kernel of the pusher of the species (dynamics_type already checked by PusherFactory)
+    //  --------------------------------------------------------------------------------------------------------------------
+    template<class InterpType, class ProjType, int nDim>
+    static ParticleKernel* create(Species * species) {
+        if ( species->dynamics_type == "norm" )
+            return new ParticleKernelT<InterpType, ProjType, PusherBoris<nDim> >();
+        else if ( species->dynamics_type == "borisnr" )
+            return new ParticleKernelT<InterpType, ProjType, PusherBorisNR<nDim> >();
+        else
+            return new ParticleKernelT<InterpType, ProjType, PusherRRLL<nDim> >();
+    }
+
+};
+
+#endif
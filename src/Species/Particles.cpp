@@ -1,6 +1,7 @@
 #include "Particles.h"
 
 #include <cstring>
+#include <algorithm>
 #include <iostream>
 
 #include "Params.h"
@@ -26,6 +27,7 @@ tracked(false)
     isRadReaction = false;
 
     double_prop.resize(0);
+    real_prop.resize(0);
     short_prop.resize(0);
     uint_prop.resize(0);
 }
@@ -57,8 +59,8 @@ void Particles::initialize(unsigned int nParticles, unsigned int nDim)
             double_prop.push_back( &(Position_old[i]) );
 #endif
         for (unsigned int i=0 ; i< 3 ; i++)
-            double_prop.push_back( &(Momentum[i]) );
-        double_prop.push_back( &Weight );
+            real_prop.push_back( &(Momentum[i]) );
+        real_prop.push_back( &Weight );
         short_prop.push_back( &Charge );
         if (tracked) {
             uint_prop.push_back( &Id );
@@ -91,14 +93,14 @@ void Particles::initialize(unsigned int nParticles, Particles &part)
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::reserve( unsigned int n_part_max, unsigned int nDim )
 {
-    return;
-
     Position.resize(nDim);
-    Position_old.resize(nDim);
-    for (unsigned int i=0 ; i< nDim ; i++) {
+    for (unsigned int i=0 ; i< nDim ; i++)
         Position[i].reserve(n_part_max);
+#ifdef  __DEBUG
+    Position_old.resize(nDim);
+    for (unsigned int i=0 ; i< nDim ; i++)
         Position_old[i].reserve(n_part_max);
-    }
+#endif
     Momentum.resize(3);
     for (unsigned int i=0 ; i< 3 ; i++) {
         Momentum[i].reserve(n_part_max);
@@ -114,8 +116,37 @@ void Particles::reserve( unsigned int n_part_max, unsigned int nDim )
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Make room for n_part particles
+//   - all properties are reallocated together, with the same capacity
+//   - capacity grows by at least 50%, rounded to a full cache line of doubles
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::ensure_capacity( unsigned int n_part )
+{
+    unsigned int current_capacity = capacity();
+    if ( n_part <= current_capacity ) return;
+    
+    unsigned int n_part_max = max( n_part, current_capacity + current_capacity/2 );
+    unsigned int chunk = SMILEI_ALIGNMENT/sizeof(double);
+    n_part_max = ( (n_part_max+chunk-1)/chunk ) * chunk;
+    
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
+        double_prop[iprop]->reserve( n_part_max );
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        real_prop[iprop]->reserve( n_part_max );
+        
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
+        short_prop[iprop]->reserve( n_part_max );
+
+    for ( unsigned int iprop=0 ; iprop<uint_prop.size() ; iprop++ ) 
+        uint_prop[iprop]->reserve( n_part_max );
+}
+
 void Particles::resize( unsigned int nParticles, unsigned int nDim )
 {
+    ensure_capacity( nParticles );
+    
     Position.resize(nDim);
     for (unsigned int i=0 ; i<nDim ; i++)
         Position[i].resize(nParticles, 0.);
@@ -144,15 +175,20 @@ void Particles::resize( unsigned int nParticles, unsigned int nDim )
 
 void Particles::shrink_to_fit( unsigned int nDim )
 {
+    // Keep a margin of 50% : avoids to reallocate the arrays at each time the number of particles oscillates
+    if ( capacity() <= size() + size()/2 ) return;
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
-        std::vector<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
+        PropertyVector<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        PropertyVector<particle_real>( *real_prop[iprop] ).swap( *real_prop[iprop] );
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
-        std::vector<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
+        PropertyVector<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
 
     for ( unsigned int iprop=0 ; iprop<uint_prop.size() ; iprop++ ) 
-        std::vector<unsigned int>( *uint_prop[iprop] ).swap( *uint_prop[iprop] );
+        PropertyVector<unsigned int>( *uint_prop[iprop] ).swap( *uint_prop[iprop] );
 }
 
 
@@ -163,6 +199,9 @@ void Particles::clear()
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         double_prop[iprop]->clear();
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        real_prop[iprop]->clear();
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         short_prop[iprop]->clear();
@@ -176,8 +215,13 @@ void Particles::clear()
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::cp_particle(unsigned int ipart, Particles &dest_parts )
 {
+    dest_parts.ensure_capacity( dest_parts.size()+1 );
+    
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         dest_parts.double_prop[iprop]->push_back( (*double_prop[iprop])[ipart] );
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        dest_parts.real_prop[iprop]->push_back( (*real_prop[iprop])[ipart] );
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         dest_parts.short_prop[iprop]->push_back( (*short_prop[iprop])[ipart] );
@@ -191,8 +235,13 @@ void Particles::cp_particle(unsigned int ipart, Particles &dest_parts )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::cp_particle(unsigned int ipart, Particles &dest_parts, int dest_id )
 {
+    dest_parts.ensure_capacity( dest_parts.size()+1 );
+    
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, (*double_prop[iprop])[ipart] );
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        dest_parts.real_prop[iprop]->insert( dest_parts.real_prop[iprop]->begin() + dest_id, (*real_prop[iprop])[ipart] );
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, (*short_prop[iprop])[ipart] );    
@@ -207,8 +256,13 @@ void Particles::cp_particle(unsigned int ipart, Particles &dest_parts, int dest_
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::cp_particles(unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id )
 {
+    dest_parts.ensure_capacity( dest_parts.size()+nPart );
+    
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, double_prop[iprop]->begin()+iPart, double_prop[iprop]->begin()+iPart+nPart );
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        dest_parts.real_prop[iprop]->insert( dest_parts.real_prop[iprop]->begin() + dest_id, real_prop[iprop]->begin()+iPart, real_prop[iprop]->begin()+iPart+nPart );
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, short_prop[iprop]->begin()+iPart, short_prop[iprop]->begin()+iPart+nPart );
@@ -218,6 +272,79 @@ void Particles::cp_particles(unsigned int iPart, unsigned int nPart, Particles &
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Shift the content of bin b of one property by shift[b] to make room in front of each bin (bins given by bmin)
+// ---------------------------------------------------------------------------------------------------------------------
+template <typename T>
+static void make_room_in_bins( PropertyVector<T> &prop, std::vector<int> &bmin, std::vector<int> &shift, unsigned int nPart )
+{
+    int bend = prop.size();
+    prop.resize( bend + nPart );
+    for ( int ibin = bmin.size()-1 ; ibin >= 0 ; ibin-- ) {
+        if ( shift[ibin] > 0 )
+            std::copy_backward( prop.begin()+bmin[ibin], prop.begin()+bend, prop.begin()+bend+shift[ibin] );
+        bend = bmin[ibin];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Insert all particles at the beginning of their bin in dest_parts, in one pass over dest_parts
+// Particles are ordered as if inserted one by one at bmin[part_bin[i]] (last inserted first)
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::cp_particles_in_bins( std::vector<int> &part_bin, Particles &dest_parts, std::vector<int> &bmin, std::vector<int> &bmax )
+{
+    unsigned int nPart = size();
+    if ( nPart == 0 ) return;
+    unsigned int nbin = bmin.size();
+    
+    // Number of new particles per bin, then shift of each bin = number of new particles in this bin and the previous ones
+    std::vector<int> shift( nbin, 0 );
+    for ( unsigned int ipart=0 ; ipart<nPart ; ipart++ )
+        shift[ part_bin[ipart] ]++;
+    for ( unsigned int ibin=1 ; ibin<nbin ; ibin++ )
+        shift[ibin] += shift[ibin-1];
+    
+    // Destination of each new particle
+    std::vector<int> dest_id( nPart );
+    std::vector<int> next( nbin );
+    for ( unsigned int ibin=0 ; ibin<nbin ; ibin++ )
+        next[ibin] = bmin[ibin] + ( ibin>0 ? shift[ibin-1] : 0 );
+    for ( int ipart=nPart-1 ; ipart>=0 ; ipart-- )
+        dest_id[ipart] = next[ part_bin[ipart] ]++;
+    
+    dest_parts.ensure_capacity( dest_parts.size()+nPart );
+    
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        make_room_in_bins( *dest_parts.double_prop[iprop], bmin, shift, nPart );
+        for ( unsigned int ipart=0 ; ipart<nPart ; ipart++ )
+            (*dest_parts.double_prop[iprop])[dest_id[ipart]] = (*double_prop[iprop])[ipart];
+    }
+    
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) {
+        make_room_in_bins( *dest_parts.real_prop[iprop], bmin, shift, nPart );
+        for ( unsigned int ipart=0 ; ipart<nPart ; ipart++ )
+            (*dest_parts.real_prop[iprop])[dest_id[ipart]] = (*real_prop[iprop])[ipart];
+    }
+    
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        make_room_in_bins( *dest_parts.short_prop[iprop], bmin, shift, nPart );
+        for ( unsigned int ipart=0 ; ipart<nPart ; ipart++ )
+            (*dest_parts.short_prop[iprop])[dest_id[ipart]] = (*short_prop[iprop])[ipart];
+    }
+    
+    for ( unsigned int iprop=0 ; iprop<uint_prop.size() ; iprop++ ) {
+        make_room_in_bins( *dest_parts.uint_prop[iprop], bmin, shift, nPart );
+        for ( unsigned int ipart=0 ; ipart<nPart ; ipart++ )
+            (*dest_parts.uint_prop[iprop])[dest_id[ipart]] = (*uint_prop[iprop])[ipart];
+    }
+    
+    // Update bins status
+    for ( unsigned int ibin=0 ; ibin<nbin ; ibin++ ) {
+        bmin[ibin] += ibin>0 ? shift[ibin-1] : 0;
+        bmax[ibin] += shift[ibin];
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Suppress particle iPart
 // ---------------------------------------------------------------------------------------------------------------------
@@ -225,6 +352,9 @@ void Particles::erase_particle(unsigned int ipart )
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart );
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        (*real_prop[iprop]).erase( (*real_prop[iprop]).begin()+ipart );
             
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart );
@@ -241,6 +371,9 @@ void Particles::erase_particle_trail(unsigned int ipart)
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart, (*double_prop[iprop]).end() );
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        (*real_prop[iprop]).erase( (*real_prop[iprop]).begin()+ipart, (*real_prop[iprop]).end() );
             
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart, (*short_prop[iprop]).end() );
@@ -256,6 +389,9 @@ void Particles::erase_particle(unsigned int ipart, unsigned int npart)
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart, (*double_prop[iprop]).begin()+ipart+npart );
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        (*real_prop[iprop]).erase( (*real_prop[iprop]).begin()+ipart, (*real_prop[iprop]).begin()+ipart+npart );
             
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart, (*short_prop[iprop]).begin()+ipart+npart );
@@ -320,6 +456,9 @@ void Particles::swap_part(unsigned int part1, unsigned int part2)
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         std::swap( (*double_prop[iprop])[part1], (*double_prop[iprop])[part2] );
 
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        std::swap( (*real_prop[iprop])[part1], (*real_prop[iprop])[part2] );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         std::swap( (*short_prop[iprop])[part1], (*short_prop[iprop])[part2] );
 
@@ -334,6 +473,9 @@ void Particles::overwrite_part(unsigned int part1, unsigned int part2)
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop])[part2] = (*double_prop[iprop])[part1];
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ )
+        (*real_prop[iprop])[part2] = (*real_prop[iprop])[part1];
     
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop])[part2] = (*short_prop[iprop])[part1];
@@ -349,12 +491,16 @@ void Particles::overwrite_part(unsigned int part1, unsigned int part2)
 void Particles::overwrite_part(unsigned int part1, unsigned int part2, unsigned int N)
 {
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizereal = N*sizeof(particle_real);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         memcpy(& (*double_prop[iprop])[part2],  &(*double_prop[iprop])[part1], sizepart);
 
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ )
+        memcpy(& (*real_prop[iprop])[part2],  &(*real_prop[iprop])[part1], sizereal);
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         memcpy(& (*short_prop[iprop])[part2] ,  &(*short_prop[iprop])[part1] , sizecharge);
     
@@ -369,6 +515,9 @@ void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsign
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         (*dest_parts.double_prop[iprop])[part2] = (*double_prop[iprop])[part1];
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) 
+        (*dest_parts.real_prop[iprop])[part2] = (*real_prop[iprop])[part1];
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         (*dest_parts.short_prop[iprop])[part2] = (*short_prop[iprop])[part1];
@@ -383,12 +532,16 @@ void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsign
 void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsigned int part2, unsigned int N)
 {
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizereal = N*sizeof(particle_real);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         memcpy(& (*dest_parts.double_prop[iprop])[part2],  &(*double_prop[iprop])[part1], sizepart);
 
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ )
+        memcpy(& (*dest_parts.real_prop[iprop])[part2],  &(*real_prop[iprop])[part1], sizereal);
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         memcpy(& (*dest_parts.short_prop[iprop])[part2] ,  &(*short_prop[iprop])[part1] , sizecharge);
     
@@ -406,6 +559,7 @@ void Particles::swap_part(unsigned int part1, unsigned int part2, unsigned int N
     double* buffer[N];
     
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizereal = N*sizeof(particle_real);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
     
@@ -415,6 +569,12 @@ void Particles::swap_part(unsigned int part1, unsigned int part2, unsigned int N
         memcpy(&((*double_prop[iprop])[part2]), buffer, sizepart);
     }
 
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ ) {
+        memcpy(buffer,&((*real_prop[iprop])[part1]), sizereal);
+        memcpy(&((*real_prop[iprop])[part1]), &((*real_prop[iprop])[part2]), sizereal);
+        memcpy(&((*real_prop[iprop])[part2]), buffer, sizereal);
+    }
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         memcpy(buffer,&((*short_prop[iprop])[part1]), sizecharge);
         memcpy(&((*short_prop[iprop])[part1]), &((*short_prop[iprop])[part2]), sizecharge);
@@ -442,8 +602,13 @@ void Particles::push_to_end(unsigned int iPart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::create_particle()
 {
+    ensure_capacity( size()+1 );
+    
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop]).push_back(0.);
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ )
+        (*real_prop[iprop]).push_back(0.);
     
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop]).push_back(0);
@@ -455,27 +620,23 @@ void Particles::create_particle()
 // ---------------------------------------------------------------------------------------------------------------------
 // Create nParticles new particles at the end of vectors
 // ---------------------------------------------------------------------------------------------------------------------
-//void Particles::create_particles(int nAdditionalParticles )
-//{
-//    int nParticles = size();
-//    for (unsigned int i=0; i<Position.size(); i++) {
-//        Position[i].resize(nParticles+nAdditionalParticles,0.);
-//        Position_old[i].resize(nParticles+nAdditionalParticles,0.);
-//    }
-//    
-//    for (unsigned int i=0; i<3; i++) {
-//        Momentum[i].resize(nParticles+nAdditionalParticles,0.);
-//    }
-//    Weight.resize(nParticles+nAdditionalParticles,0.);
-//    Charge.resize(nParticles+nAdditionalParticles,0);
-//    
-//    if (tracked)
-//        Id.resize(nParticles+nAdditionalParticles,0);
-//    
-//    if (isRadReaction)
-//        Chi.resize(nParticles+nAdditionalParticles,0.);
-//
-//}
+void Particles::create_particles(unsigned int nAdditionalParticles )
+{
+    unsigned int nParticles = size()+nAdditionalParticles;
+    ensure_capacity( nParticles );
+    
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        (*double_prop[iprop]).resize(nParticles, 0.);
+
+    for ( unsigned int iprop=0 ; iprop<real_prop.size() ; iprop++ )
+        (*real_prop[iprop]).resize(nParticles, 0.);
+    
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        (*short_prop[iprop]).resize(nParticles, 0);
+
+    for ( unsigned int iprop=0 ; iprop<uint_prop.size() ; iprop++ )
+        (*uint_prop[iprop]).resize(nParticles, 0);
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Test if ipart is in the local patch
@@ -9,12 +9,24 @@
 
 #include "Tools.h"
 #include "TimeSelection.h"
+#include "AlignedAllocator.h"
 
 class Particle;
 
 class Params;
 class Patch;
 
+//! Storage of one particle property : a contiguous array aligned on SMILEI_ALIGNMENT bytes
+template<typename T>
+using PropertyVector = std::vector< T, AlignedAllocator<T> >;
+
+//! Floating point type used to store the particle momenta and weights
+//! Single precision if compiled with config=single_particles (positions and all computations remain in double)
+#ifdef __SINGLE_PARTICLES
+typedef float  particle_real;
+#else
+typedef double particle_real;
+#endif
 
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -38,6 +50,9 @@ public:
     //! Set capacity of Particles vectors
     void reserve( unsigned int n_part_max, unsigned int nDim );
     
+    //! Make room for n_part particles, all properties being grown at once following the same policy
+    void ensure_capacity( unsigned int n_part );
+    
     //! Resize Particles vectors
     void resize( unsigned int nParticles, unsigned int nDim );
     
@@ -69,6 +84,9 @@ public:
     void cp_particles(unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id );
     //! Insert particle iPart at dest_id in dest_parts
     void cp_particle(unsigned int ipart, Particles &dest_parts, int dest_id );
+    //! Insert all particles at the beginning of their bin in dest_parts (particle i goes in bin part_bin[i]), updating bmin/bmax
+    //! Existing particles are moved once, whatever the number of inserted particles
+    void cp_particles_in_bins( std::vector<int> &part_bin, Particles &dest_parts, std::vector<int> &bmin, std::vector<int> &bmax );
     
     //! Suppress particle iPart
     void erase_particle(unsigned int iPart );
@@ -133,7 +151,7 @@ public:
     }
     
     //! Method used to get the list of Particle position
-    inline std::vector<double>  position(unsigned int idim) const {
+    inline PropertyVector<double>  position(unsigned int idim) const {
         return Position[idim];
     }
     
@@ -142,11 +160,11 @@ public:
         return Momentum[idim][ipart];
     }
     //! Method used to set a new value to the Particle momentum
-    inline double& momentum( unsigned int idim, unsigned int ipart )       {
+    inline particle_real& momentum( unsigned int idim, unsigned int ipart )       {
         return Momentum[idim][ipart];
     }
       //! Method used to get the Particle momentum
-    inline std::vector<double>  momentum( unsigned int idim ) const {
+    inline PropertyVector<particle_real>  momentum( unsigned int idim ) const {
         return Momentum[idim];
     }
     
@@ -155,11 +173,11 @@ public:
         return Weight[ipart];
     }
     //! Method used to set a new value to the Particle weight
-    inline double& weight(unsigned int ipart)       {
+    inline particle_real& weight(unsigned int ipart)       {
         return Weight[ipart];
     }
     //! Method used to get the Particle weight
-    inline std::vector<double>  weight() const {
+    inline PropertyVector<particle_real>  weight() const {
         return Weight;
     }
     
@@ -172,7 +190,7 @@ public:
         return Charge[ipart];
     }
     //! Method used to get the list of Particle charges
-    inline std::vector<short>  charge() const {
+    inline PropertyVector<short>  charge() const {
         return Charge;
     }
     
@@ -182,29 +200,29 @@ public:
         return sqrt(1.+pow(momentum(0,ipart),2)+pow(momentum(1,ipart),2)+pow(momentum(2,ipart),2));
     }
     
-    //! Partiles properties, respect type order : all double, all short, all unsigned int
+    //! Partiles properties, respect type order : all double, all particle_real, all short, all unsigned int
     
     //! array containing the particle position
-    std::vector< std::vector<double> > Position;
+    std::vector< PropertyVector<double> > Position;
     
     //! array containing the particle former (old) positions
-    std::vector< std::vector<double> >Position_old;
+    std::vector< PropertyVector<double> > Position_old;
     
     //! array containing the particle moments
-    std::vector< std::vector<double> >  Momentum;
+    std::vector< PropertyVector<particle_real> > Momentum;
     
     //! containing the particle weight: equivalent to a charge density
-    std::vector<double> Weight;
+    PropertyVector<particle_real> Weight;
     
     //! containing the particle weight: equivalent to a charge density
-    std::vector<double> Chi;
+    PropertyVector<double> Chi;
     
     
     //! charge state of the particle (multiples of e>0)
-    std::vector<short> Charge;
+    PropertyVector<short> Charge;
     
     //! Id of the particle
-    std::vector<unsigned int> Id;
+    PropertyVector<unsigned int> Id;
     
     // TEST PARTICLE PARAMETERS
     bool isTest;
@@ -236,7 +254,7 @@ public:
         return Id[ipart];
     }
     //! Method used to get the Particle Ids
-    inline std::vector<unsigned int> id() const {
+    inline PropertyVector<unsigned int> id() const {
         return Id;
     }
     void sortById();
@@ -256,13 +274,14 @@ public:
         return Chi[ipart];
     }
     //! Method used to get the Particle chi factor
-    inline std::vector<double>  chi() const {
+    inline PropertyVector<double>  chi() const {
         return Chi;
     }
     
-    std::vector< std::vector<double>* >       double_prop;
-    std::vector< std::vector<short>* >        short_prop;
-    std::vector< std::vector<unsigned int>* > uint_prop;
+    std::vector< PropertyVector<double>* >       double_prop;
+    std::vector< PropertyVector<particle_real>* > real_prop;
+    std::vector< PropertyVector<short>* >        short_prop;
+    std::vector< PropertyVector<unsigned int>* > uint_prop;
     
     
     //bool test_move( int iPartStart, int iPartEnd, Params& params );
@@ -18,8 +18,8 @@ public:
     Pusher(Params& params, Species *species);
     virtual ~Pusher();
 
-    //! Overloading of () operator
-    virtual void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread) = 0;
+    //! Overloading of () operator (the smpi buffers of particle ipart are at index ipart-ipart_ref)
+    virtual void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0) = 0;
 
 protected:
     double dt, dts2;
@@ -9,12 +9,14 @@
 
 using namespace std;
 
-PusherBoris::PusherBoris(Params& params, Species *species)
+template<int nDim>
+PusherBoris<nDim>::PusherBoris(Params& params, Species *species)
     : Pusher(params, species)
 {
 }
 
-PusherBoris::~PusherBoris()
+template<int nDim>
+PusherBoris<nDim>::~PusherBoris()
 {
 }
 
@@ -22,81 +24,86 @@ PusherBoris::~PusherBoris()
     Lorentz Force -- leap-frog (Boris) scheme
 ***********************************************************************/
 
-void PusherBoris::operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
+template<int nDim>
+void PusherBoris<nDim>::operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
-    std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
-
-    double charge_over_mass_dts2;
-    double umx, umy, umz, upx, upy, upz;
-    double alpha, inv_det_T, Tx, Ty, Tz, Tx2, Ty2, Tz2;
-    double TxTy, TyTz, TzTx;
-    double pxsm, pysm, pzsm;
-    double local_invgf;
-
-    double* momentum[3];
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
+    double* Ex = smpi->dynamics_Epart[ithread].data() + 0*nparts;
+    double* Ey = smpi->dynamics_Epart[ithread].data() + 1*nparts;
+    double* Ez = smpi->dynamics_Epart[ithread].data() + 2*nparts;
+    double* Bx = smpi->dynamics_Bpart[ithread].data() + 0*nparts;
+    double* By = smpi->dynamics_Bpart[ithread].data() + 1*nparts;
+    double* Bz = smpi->dynamics_Bpart[ithread].data() + 2*nparts;
+    double* invgf = smpi->dynamics_invgf[ithread].data();
+
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
     double* position[3];
-    for ( int i = 0 ; i<nDim_ ; i++ )
+    for ( int i = 0 ; i<nDim ; i++ )
         position[i] =  &( particles.position(i,0) );
 #ifdef  __DEBUG
     double* position_old[3];
-    for ( int i = 0 ; i<nDim_ ; i++ )
+    for ( int i = 0 ; i<nDim ; i++ )
         position_old[i] =  &( particles.position_old(i,0) );
 #endif
     short* charge = &( particles.charge(0) );
 
     #pragma omp simd
     for (int ipart=istart ; ipart<iend; ipart++ ) {
-        charge_over_mass_dts2 = (double)(charge[ipart])*one_over_mass_*dts2;
+        double charge_over_mass_dts2 = (double)(charge[ipart])*one_over_mass_*dts2;
 
         // init Half-acceleration in the electric field
-        pxsm = charge_over_mass_dts2*(*Epart)[ipart].x;
-        pysm = charge_over_mass_dts2*(*Epart)[ipart].y;
-        pzsm = charge_over_mass_dts2*(*Epart)[ipart].z;
+        double pxsm = charge_over_mass_dts2*Ex[ipart-ipart_ref];
+        double pysm = charge_over_mass_dts2*Ey[ipart-ipart_ref];
+        double pzsm = charge_over_mass_dts2*Ez[ipart-ipart_ref];
 
-        //(*this)(particles, ipart, (*Epart)[ipart], (*Bpart)[ipart] , (*invgf)[ipart]);
-        umx = momentum[0][ipart] + pxsm;
-        umy = momentum[1][ipart] + pysm;
-        umz = momentum[2][ipart] + pzsm;
-        local_invgf = 1. / sqrt( 1.0 + umx*umx + umy*umy + umz*umz );
+        double umx = momentum[0][ipart] + pxsm;
+        double umy = momentum[1][ipart] + pysm;
+        double umz = momentum[2][ipart] + pzsm;
+        double local_invgf = 1. / sqrt( 1.0 + umx*umx + umy*umy + umz*umz );
 
         // Rotation in the magnetic field
-        alpha = charge_over_mass_dts2*local_invgf;
-        Tx    = alpha * (*Bpart)[ipart].x;
-        Ty    = alpha * (*Bpart)[ipart].y;
-        Tz    = alpha * (*Bpart)[ipart].z;
-        Tx2   = Tx*Tx;
-        Ty2   = Ty*Ty;
-        Tz2   = Tz*Tz;
-        TxTy  = Tx*Ty;
-        TyTz  = Ty*Tz;
-        TzTx  = Tz*Tx;
-        inv_det_T = 1.0/(1.0+Tx2+Ty2+Tz2);
-
-        upx = (  (1.0+Tx2-Ty2-Tz2)* umx  +      2.0*(TxTy+Tz)* umy  +      2.0*(TzTx-Ty)* umz  )*inv_det_T;
-        upy = (      2.0*(TxTy-Tz)* umx  +  (1.0-Tx2+Ty2-Tz2)* umy  +      2.0*(TyTz+Tx)* umz  )*inv_det_T;
-        upz = (      2.0*(TzTx+Ty)* umx  +      2.0*(TyTz-Tx)* umy  +  (1.0-Tx2-Ty2+Tz2)* umz  )*inv_det_T;
+        double alpha = charge_over_mass_dts2*local_invgf;
+        double Tx    = alpha * Bx[ipart-ipart_ref];
+        double Ty    = alpha * By[ipart-ipart_ref];
+        double Tz    = alpha * Bz[ipart-ipart_ref];
+        double Tx2   = Tx*Tx;
+        double Ty2   = Ty*Ty;
+        double Tz2   = Tz*Tz;
+        double TxTy  = Tx*Ty;
+        double TyTz  = Ty*Tz;
+        double TzTx  = Tz*Tx;
+        double inv_det_T = 1.0/(1.0+Tx2+Ty2+Tz2);
+
+        double upx = (  (1.0+Tx2-Ty2-Tz2)* umx  +      2.0*(TxTy+Tz)* umy  +      2.0*(TzTx-Ty)* umz  )*inv_det_T;
+        double upy = (      2.0*(TxTy-Tz)* umx  +  (1.0-Tx2+Ty2-Tz2)* umy  +      2.0*(TyTz+Tx)* umz  )*inv_det_T;
+        double upz = (      2.0*(TzTx+Ty)* umx  +      2.0*(TyTz-Tx)* umy  +  (1.0-Tx2-Ty2+Tz2)* umz  )*inv_det_T;
 
         // finalize Half-acceleration in the electric field
         pxsm += upx;
         pysm += upy;
         pzsm += upz;
-        (*invgf)[ipart] = 1. / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
+        invgf[ipart-ipart_ref] = 1. / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
 
         momentum[0][ipart] = pxsm;
         momentum[1][ipart] = pysm;
         momentum[2][ipart] = pzsm;
+    }
 
-        // Move the particle
+    // Move the particles (one loop per dimension, so that the loops have no inner branch and vectorize)
+    for ( int i = 0 ; i<nDim ; i++ ) {
 #ifdef  __DEBUG
-        for ( int i = 0 ; i<nDim_ ; i++ ) 
-          position_old[i][ipart] = position[i][ipart];
+        for (int ipart=istart ; ipart<iend; ipart++ )
+            position_old[i][ipart] = position[i][ipart];
 #endif
-        for ( int i = 0 ; i<nDim_ ; i++ ) 
-            position[i][ipart]     += dt*momentum[i][ipart]*(*invgf)[ipart];
-
+        #pragma omp simd
+        for (int ipart=istart ; ipart<iend; ipart++ )
+            position[i][ipart] += dt*momentum[i][ipart]*invgf[ipart-ipart_ref];
     }
 }
+
+// Instantiations for the 1D, 2D and 3D geometries
+template class PusherBoris<1>;
+template class PusherBoris<2>;
+template class PusherBoris<3>;
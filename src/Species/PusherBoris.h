@@ -11,15 +11,16 @@
 #include "Pusher.h"
 
 //  --------------------------------------------------------------------------------------------------------------------
-//! Class PusherBoris
+//! Class PusherBoris, for nDim particle dimensions (the position update is unrolled at compile time)
 //  --------------------------------------------------------------------------------------------------------------------
+template<int nDim>
 class PusherBoris : public Pusher {
 public:
     //! Creator for Pusher
     PusherBoris(Params& params, Species *species);
     ~PusherBoris();
     //! Overloading of () operator
-    virtual void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread);
+    void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0) override final;
 
 };
 
@@ -7,12 +7,14 @@
 
 using namespace std;
 
-PusherBorisNR::PusherBorisNR(Params& params, Species *species)
+template<int nDim>
+PusherBorisNR<nDim>::PusherBorisNR(Params& params, Species *species)
     : Pusher(params, species)
 {
 }
 
-PusherBorisNR::~PusherBorisNR()
+template<int nDim>
+PusherBorisNR<nDim>::~PusherBorisNR()
 {
 }
 
@@ -20,10 +22,16 @@ PusherBorisNR::~PusherBorisNR()
     Lorentz Force -- leap-frog (Boris) scheme
 ***********************************************************************/
 
-void PusherBorisNR::operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
+template<int nDim>
+void PusherBorisNR<nDim>::operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
+    double* Ex = smpi->dynamics_Epart[ithread].data() + 0*nparts;
+    double* Ey = smpi->dynamics_Epart[ithread].data() + 1*nparts;
+    double* Ez = smpi->dynamics_Epart[ithread].data() + 2*nparts;
+    double* Bx = smpi->dynamics_Bpart[ithread].data() + 0*nparts;
+    double* By = smpi->dynamics_Bpart[ithread].data() + 1*nparts;
+    double* Bz = smpi->dynamics_Bpart[ithread].data() + 2*nparts;
 
     double charge_over_mass_ ;
     double umx, umy, umz;
@@ -39,16 +47,16 @@ void PusherBorisNR::operator() (Particles &particles, SmileiMPI* smpi, int istar
         alpha = charge_over_mass_*dts2;
 
         // uminus = v + q/m * dt/2 * E
-        umx = particles.momentum(0, ipart) * one_over_mass_ + alpha * (*Epart)[ipart].x;
-        umy = particles.momentum(1, ipart) * one_over_mass_ + alpha * (*Epart)[ipart].y;
-        umz = particles.momentum(2, ipart) * one_over_mass_ + alpha * (*Epart)[ipart].z;
+        umx = particles.momentum(0, ipart) * one_over_mass_ + alpha * Ex[ipart-ipart_ref];
+        umy = particles.momentum(1, ipart) * one_over_mass_ + alpha * Ey[ipart-ipart_ref];
+        umz = particles.momentum(2, ipart) * one_over_mass_ + alpha * Ez[ipart-ipart_ref];
 
 
         // Rotation in the magnetic field
 
-        Tx    = alpha * (*Bpart)[ipart].x;
-        Ty    = alpha * (*Bpart)[ipart].y;
-        Tz    = alpha * (*Bpart)[ipart].z;
+        Tx    = alpha * Bx[ipart-ipart_ref];
+        Ty    = alpha * By[ipart-ipart_ref];
+        Tz    = alpha * Bz[ipart-ipart_ref];
 
         T2 = Tx*Tx + Ty*Ty + Tz*Tz;
 
@@ -62,12 +70,17 @@ void PusherBorisNR::operator() (Particles &particles, SmileiMPI* smpi, int istar
         upz = umz + umx*Sy - umy*Sx;
 
 
-        particles.momentum(0, ipart) = mass_ * (upx + alpha*(*Epart)[ipart].x);
-        particles.momentum(1, ipart) = mass_ * (upy + alpha*(*Epart)[ipart].y);
-        particles.momentum(2, ipart) = mass_ * (upz + alpha*(*Epart)[ipart].z);
+        particles.momentum(0, ipart) = mass_ * (upx + alpha*Ex[ipart-ipart_ref]);
+        particles.momentum(1, ipart) = mass_ * (upy + alpha*Ey[ipart-ipart_ref]);
+        particles.momentum(2, ipart) = mass_ * (upz + alpha*Ez[ipart-ipart_ref]);
 
         // Move the particle
-        for ( int i = 0 ; i<nDim_ ; i++ )
+        for ( int i = 0 ; i<nDim ; i++ )
             particles.position(i, ipart)     += dt*particles.momentum(i, ipart);
     }
 }
+
+// Instantiations for the 1D, 2D and 3D geometries
+template class PusherBorisNR<1>;
+template class PusherBorisNR<2>;
+template class PusherBorisNR<3>;
@@ -11,8 +11,9 @@
 #include "Pusher.h"
 
 //  --------------------------------------------------------------------------------------------------------------------
-//! Class PusherBorisNR
+//! Class PusherBorisNR, for nDim particle dimensions (the position update is unrolled at compile time)
 //  --------------------------------------------------------------------------------------------------------------------
+template<int nDim>
 class PusherBorisNR : public Pusher {
 public:
     //! Creator for Pusher
@@ -20,7 +21,7 @@ public:
     ~PusherBorisNR();
 
     //! Overriding operator()
-    virtual void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread);
+    void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0) override final;
 
 };
 
@@ -28,15 +28,15 @@ public:
         // assign the correct Pusher to Push
         if ( species->dynamics_type == "norm" )
         {
-            Push = new PusherBoris( params, species );
+            Push = create<PusherBoris>( params, species );
         }
         else if ( species->dynamics_type == "borisnr" )
         {
-            Push = new PusherBorisNR( params, species );
+            Push = create<PusherBorisNR>( params, species );
         }
         else if ( species->dynamics_type == "rrll" )
         {
-            Push = new PusherRRLL( params, species );
+            Push = create<PusherRRLL>( params, species );
         }
         else {
             ERROR( "For species " << species->species_type << ": unknown dynamics_type `" << species->dynamics_type << "`");
@@ -45,6 +45,19 @@ public:
         return Push;
     }
 
+    //  --------------------------------------------------------------------------------------------------------------------
+    //! Create the pusher specialized on the number of dimensions of the particles
+    //  --------------------------------------------------------------------------------------------------------------------
+    template<template<int> class PusherType>
+    static Pusher* create(Params& params, Species * species) {
+        if ( params.nDim_particle == 1 )
+            return new PusherType<1>( params, species );
+        else if ( params.nDim_particle == 2 )
+            return new PusherType<2>( params, species );
+        else
+            return new PusherType<3>( params, species );
+    }
+
 };
 
 #endif
@@ -8,19 +8,22 @@
 
 using namespace std;
 
-PusherRRLL::PusherRRLL(Params& params, Species *species)
+template<int nDim>
+PusherRRLL<nDim>::PusherRRLL(Params& params, Species *species)
     : Pusher(params, species)
 {
 }
 
-PusherRRLL::~PusherRRLL()
+template<int nDim>
+PusherRRLL<nDim>::~PusherRRLL()
 {
 }
 
 /****************************************************************************
     Lorentz Force -- leap-frog (Boris) scheme + classical rad. reaction force
 *****************************************************************************/
-void PusherRRLL::operator() (Particles &particles, int ipart, LocalFields Epart, LocalFields Bpart, double& invgf)
+template<int nDim>
+void PusherRRLL<nDim>::operator() (Particles &particles, int ipart, LocalFields Epart, LocalFields Bpart, double& invgf)
 {
     // Declaration of local variables
     // ------------------------------
@@ -71,7 +74,7 @@ void PusherRRLL::operator() (Particles &particles, int ipart, LocalFields Epart,
     particles.momentum(2, ipart) = pzsm;
 
     // Move the particle
-    for ( int i = 0 ; i<nDim_ ; i++ ) {
+    for ( int i = 0 ; i<nDim ; i++ ) {
         //particles.position_old(i, ipart)  = particles.position(i, ipart);
         particles.position(i, ipart)     += dt*particles.momentum(i, ipart)*invgf;
     }
@@ -81,10 +84,16 @@ void PusherRRLL::operator() (Particles &particles, int ipart, LocalFields Epart,
     //DEBUG(5, "\t END "<< particles.position(0, ipart) );
 
 }
-void PusherRRLL::operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
+template<int nDim>
+void PusherRRLL<nDim>::operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
+    int nparts = smpi->dynamics_Epart[ithread].size()/3;
+    double* Ex = smpi->dynamics_Epart[ithread].data() + 0*nparts;
+    double* Ey = smpi->dynamics_Epart[ithread].data() + 1*nparts;
+    double* Ez = smpi->dynamics_Epart[ithread].data() + 2*nparts;
+    double* Bx = smpi->dynamics_Bpart[ithread].data() + 0*nparts;
+    double* By = smpi->dynamics_Bpart[ithread].data() + 1*nparts;
+    double* Bz = smpi->dynamics_Bpart[ithread].data() + 2*nparts;
     std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
     double charge_over_mass_ ;
     double umx, umy, umz, upx, upy, upz;
@@ -97,16 +106,16 @@ void PusherRRLL::operator() (Particles &particles, SmileiMPI* smpi, int istart,
         //(*this)(particles, iPart, (*Epart)[iPart], (*Bpart)[iPart] , (*invgf)[iPart]);
         charge_over_mass_ = static_cast<double>(particles.charge(ipart))*one_over_mass_;
         // Half-acceleration in the electric field
-        umx = particles.momentum(0, ipart) + charge_over_mass_*(*Epart)[ipart].x*dts2;
-        umy = particles.momentum(1, ipart) + charge_over_mass_*(*Epart)[ipart].y*dts2;
-        umz = particles.momentum(2, ipart) + charge_over_mass_*(*Epart)[ipart].z*dts2;
+        umx = particles.momentum(0, ipart) + charge_over_mass_*Ex[ipart-ipart_ref]*dts2;
+        umy = particles.momentum(1, ipart) + charge_over_mass_*Ey[ipart-ipart_ref]*dts2;
+        umz = particles.momentum(2, ipart) + charge_over_mass_*Ez[ipart-ipart_ref]*dts2;
         local_invgf  = 1. / sqrt( 1.0 + umx*umx + umy*umy + umz*umz );
 
         // Rotation in the magnetic field
         alpha = charge_over_mass_*dts2*local_invgf;
-        Tx    = alpha * (*Bpart)[ipart].x;
-        Ty    = alpha * (*Bpart)[ipart].y;
-        Tz    = alpha * (*Bpart)[ipart].z;
+        Tx    = alpha * Bx[ipart-ipart_ref];
+        Ty    = alpha * By[ipart-ipart_ref];
+        Tz    = alpha * Bz[ipart-ipart_ref];
         Tx2   = Tx*Tx;
         Ty2   = Ty*Ty;
         Tz2   = Tz*Tz;
@@ -120,21 +129,26 @@ void PusherRRLL::operator() (Particles &particles, SmileiMPI* smpi, int istart,
         upz = (      2.0*(TzTx+Ty)* umx  +      2.0*(TyTz-Tx)* umy  +  (1.0-Tx2-Ty2+Tz2)* umz  )*inv_det_T;
 
         // Half-acceleration in the electric field
-        pxsm = upx + charge_over_mass_*(*Epart)[ipart].x*dts2;
-        pysm = upy + charge_over_mass_*(*Epart)[ipart].y*dts2;
-        pzsm = upz + charge_over_mass_*(*Epart)[ipart].z*dts2;
-        (*invgf)[ipart] = 1. / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
+        pxsm = upx + charge_over_mass_*Ex[ipart-ipart_ref]*dts2;
+        pysm = upy + charge_over_mass_*Ey[ipart-ipart_ref]*dts2;
+        pzsm = upz + charge_over_mass_*Ez[ipart-ipart_ref]*dts2;
+        (*invgf)[ipart-ipart_ref] = 1. / sqrt( 1.0 + pxsm*pxsm + pysm*pysm + pzsm*pzsm );
 
         particles.momentum(0, ipart) = pxsm;
         particles.momentum(1, ipart) = pysm;
         particles.momentum(2, ipart) = pzsm;
 
         // Move the particle
-        for ( int i = 0 ; i<nDim_ ; i++ )
-            particles.position(i, ipart)     += dt*particles.momentum(i, ipart)*(*invgf)[ipart];
+        for ( int i = 0 ; i<nDim ; i++ )
+            particles.position(i, ipart)     += dt*particles.momentum(i, ipart)*(*invgf)[ipart-ipart_ref];
 
         // COMPUTE Chi
         particles.chi(ipart)=0.5;
         //DEBUG(5, "\t END "<< particles.position(0, ipart) );
     }
 }
+
+// Instantiations for the 1D, 2D and 3D geometries
+template class PusherRRLL<1>;
+template class PusherRRLL<2>;
+template class PusherRRLL<3>;
@@ -11,16 +11,17 @@
 #include "Pusher.h"
 
 //  --------------------------------------------------------------------------------------------------------------------
-//! Class PusherBoris
+//! Class PusherRRLL, for nDim particle dimensions (the position update is unrolled at compile time)
 //  --------------------------------------------------------------------------------------------------------------------
-class PusherRRLL: public Pusher {
+template<int nDim>
+class PusherRRLL : public Pusher {
 public:
     //! Creator for Pusher
     PusherRRLL(Params& params, Species*);
     ~PusherRRLL();
     //! Overloading of () operator
     virtual void operator() (Particles &particles, int ipart, LocalFields Epart, LocalFields Bpart, double& invgf);
-    virtual void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread);
+    void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0) override final;
 
 };
 
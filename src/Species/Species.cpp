@@ -12,6 +12,7 @@
 #include <cstring>
 // IDRIS
 #include "PusherFactory.h"
+#include "ParticleKernelFactory.h"
 #include "IonizationFactory.h"
 #include "PartBoundCond.h"
 #include "PartWall.h"
@@ -43,15 +44,24 @@ using namespace std;
 Species::Species(Params& params, Patch* patch) :
 c_part_max(1),
 dynamics_type("norm"), 
+dynamics_block_size(0),
+bin_tiles(false),
+vectorized_projection(false),
+split_patch_threshold(0),
 time_frozen(0), 
 radiating(false), 
 ionization_model("none"),
 velocityProfile(3,NULL),
 temperatureProfile(3,NULL),
-particles(&particles_sorted[0]),
+bins_shared(false),
+empty(false),
+particles(&particles_storage),
 electron_species(NULL),
 clrw(params.clrw),  
+sort_by_cell(false),
+sort_threshold(0.),
 oversize(params.oversize), 
+n_space(params.n_space), 
 cell_length(params.cell_length), 
 min_loc_vec(patch->getDomainLocalMin()), 
 partBoundCond(NULL),
@@ -111,6 +121,9 @@ void Species::initCluster(Params& params)
     nrj_bc_lost = 0.;
     nrj_mw_lost = 0.;
     nrj_new_particles = 0.;
+    
+    npart_out_of_bin = 0;
+    npart_unsorted = 0;
    
 }//END initCluster
 
@@ -120,9 +133,15 @@ void Species::initCluster(Params& params)
 // the parameters but not the operators.
 void Species::initOperators(Params& params, Patch* patch)
 {
+    // random numbers of the patch (the stream is chosen at each timestep)
+    random.seed( params.random_seed, patch->Hindex() );
+    
     // assign the correct Pusher to Push
     Push = PusherFactory::create(params, this);
     
+    // assign the kernel specialized on the interpolator, projector and pusher
+    Kernel = ParticleKernelFactory::create(params, this);
+    
     // Assign the Ionization model (if needed) to Ionize
     //  Needs to be placed after createParticles() because requires the knowledge of max_charge
     // \todo pay attention to restart
@@ -156,6 +175,7 @@ void Species::initOperators(Params& params, Patch* patch)
 Species::~Species()
 {
     delete Push;
+    delete Kernel;
     if (Ionize) delete Ionize;
     if (partBoundCond) delete partBoundCond;
     if (ppcProfile) delete ppcProfile;
@@ -245,10 +265,11 @@ void Species::initPosition(unsigned int nPart, unsigned int iPart, double *index
         
     } else if (initPosition_type == "random") {
         
-        for (unsigned int p= iPart; p<iPart+nPart; p++) {
-            for (unsigned int i=0; i<nDim_particle ; i++) {
-                (*particles).position(i,p)=indexes[i]+(((double)rand() / RAND_MAX))*cell_length[i];
-            }
+        for (unsigned int i=0; i<nDim_particle ; i++) {
+            double* position = &( (*particles).position(i,0) );
+            random.uniform( &position[iPart], nPart );
+            for (unsigned int p= iPart; p<iPart+nPart; p++)
+                position[p] = indexes[i] + position[p]*cell_length[i];
         }
         
     } else if (initPosition_type == "centered") {
@@ -290,8 +311,8 @@ void Species::initMomentum(unsigned int nPart, unsigned int iPart, double *temp,
         
         // Sample angles randomly and calculate the momentum
         for (unsigned int p=iPart; p<iPart+nPart; p++) {
-            double phi   = acos(1.0-2.0*(double)rand() / RAND_MAX);
-            double theta = 2.0*M_PI*(double)rand() / RAND_MAX;
+            double phi   = acos(1.0-2.0*random.uniform());
+            double theta = 2.0*M_PI*random.uniform();
             double psm = sqrt(pow(1.0+energies[p-iPart],2)-1.0);
             
             (*particles).momentum(0,p) = psm*cos(theta)*sin(phi);
@@ -318,9 +339,9 @@ void Species::initMomentum(unsigned int nPart, unsigned int iPart, double *temp,
     } else if (initMomentum_type == "rectangular") {
         
         for (unsigned int p= iPart; p<iPart+nPart; p++) {
-            (*particles).momentum(0,p) = (2.*(double)rand() / RAND_MAX - 1.) * sqrt(temp[0]/mass);
-            (*particles).momentum(1,p) = (2.*(double)rand() / RAND_MAX - 1.) * sqrt(temp[1]/mass);
-            (*particles).momentum(2,p) = (2.*(double)rand() / RAND_MAX - 1.) * sqrt(temp[2]/mass);
+            (*particles).momentum(0,p) = (2.*random.uniform() - 1.) * sqrt(temp[0]/mass);
+            (*particles).momentum(1,p) = (2.*random.uniform() - 1.) * sqrt(temp[1]/mass);
+            (*particles).momentum(2,p) = (2.*random.uniform() - 1.) * sqrt(temp[2]/mass);
         }
     }
     
@@ -348,7 +369,7 @@ void Species::initMomentum(unsigned int nPart, unsigned int iPart, double *temp,
         Lyz = gm1 * vy*vz/v2;
         
         // Volume transformation method (here is the correction by Zenitani)
-        double Volume_Acc = (double)rand() / RAND_MAX;
+        double Volume_Acc = random.uniform();
         double CheckVelocity;
         
         // Lorentz transformation of the momentum
@@ -431,16 +452,12 @@ void Species::dynamics(double time_dual, unsigned int ispec, ElectroMagn* EMfiel
         ithread = 0;
     #endif
 
-    // Ionization current
-    LocalFields Jion;
-    
     unsigned int iPart;
     
     // Reset list of particles to exchange
     clearExchList();
 
     int tid(0);
-    double ener_iPart(0.);
     std::vector<double> nrj_lost_per_thd(1, 0.);
             
     // -------------------------------
@@ -448,100 +465,26 @@ void Species::dynamics(double time_dual, unsigned int ispec, ElectroMagn* EMfiel
     // -------------------------------
     if (time_dual>time_frozen) { // moving particle
     
-        smpi->dynamics_resize(ithread, nDim_particle, bmax.back());
-
-        //Point to local thread dedicated buffers
-        //Still needed for ionization
-        std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-
-        for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin++) {
-
-            // Interpolate the fields at the particle position
-            (*Interp)(EMfields, *particles, smpi, bmin[ibin], bmax[ibin], ithread );
-
-            //Ionization
-            if (Ionize){                                
-                for (iPart=bmin[ibin] ; (int)iPart<bmax[ibin]; iPart++ ) {
-                    // Do the ionization (!for testParticles)
-                    if ( (*particles).charge(iPart) < (int) atomic_number) {
-                        //!\todo Check if it is necessary to put to 0 or if LocalFields ensures it
-                        Jion.x=0.0;
-                        Jion.y=0.0;
-                        Jion.z=0.0;
-                        (*Ionize)(*particles, iPart, (*Epart)[iPart], Jion);
-                        (*Proj)(EMfields->Jx_, EMfields->Jy_, EMfields->Jz_, *particles, iPart, Jion);
-                    }
-                }
-            }    
-                
-            // Push the particles
-            (*Push)(*particles, smpi, bmin[ibin], bmax[ibin], ithread );
-            //for (iPart=bmin[ibin] ; iPart<bmax[ibin]; iPart++ ) 
-            //    (*Push)(*particles, iPart, (*Epart)[iPart], (*Bpart)[iPart] , (*invgf)[iPart]);
-
-            //particles->test_move( bmin[ibin], bmax[ibin], params );
+        // Buffers hold either all the particles (staged) or one block of particles (fused)
+        smpi->dynamics_resize(ithread, nDim_particle, dynamics_block_size>0 ? dynamics_block_size : bmax.back());
 
-
-            // Apply wall and boundary conditions
-            for(unsigned int iwall=0; iwall<partWalls->size(); iwall++) {
-                for (iPart=bmin[ibin] ; (int)iPart<bmax[ibin]; iPart++ ) {
-                    double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                    if ( !(*partWalls)[iwall]->apply(*particles, iPart, this, dtgf, ener_iPart)) {
-                        nrj_lost_per_thd[tid] += mass * ener_iPart;
-                    }
-                }
-            }
-            // Boundary Condition may be physical or due to domain decomposition
-            // apply returns 0 if iPart is not in the local domain anymore
-            //        if omp, create a list per thread
-            for (iPart=bmin[ibin] ; (int)iPart<bmax[ibin]; iPart++ ) {
-                if ( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
-                    addPartInExchList( iPart );
-                    //nrj_lost_per_thd[tid] += ener_iPart;
-                    nrj_lost_per_thd[tid] += mass * ener_iPart;
-                }
-             }
-
-            //START EXCHANGE PARTICLES OF THE CURRENT BIN ?
-
-             // Project currents if not a Test species and charges as well if a diag is needed. 
-             if (!(*particles).isTest)
-                 (*Proj)(EMfields, *particles, smpi, bmin[ibin], bmax[ibin], ithread, ibin, clrw, diag_flag, b_dim, ispec );
-
-        }// ibin
+        for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin++)
+            dynamics_bin(ibin, ithread, ispec, EMfields, Interp, Proj, params, diag_flag, partWalls, smpi,
+                         indexes_of_particles_to_exchange, nrj_lost_per_thd[tid], npart_out_of_bin, npart_unsorted);
 
         for (unsigned int ithd=0 ; ithd<nrj_lost_per_thd.size() ; ithd++)
             nrj_bc_lost += nrj_lost_per_thd[tid];
+        
+        // Exchanged particles leave holes filled by the end of their bin, and arrive at the end of a bin
+        npart_unsorted += indexes_of_particles_to_exchange.size();
 
-        // Needs to be reviewed 
-        if (Ionize) {
-            for (unsigned int i=0; i < Ionize->new_electrons.size(); i++) {
-                // electron_species->(*particles).push_back(Ionize->new_electrons[i]);
-                                
-                int ibin = (int) ((Ionize->new_electrons).position(0,i) / cell_length[0]) - ( patch->getCellStartingGlobalIndex(0) + oversize[0] );
-                DEBUG("here " << ibin << " " << (Ionize->new_electrons).position(0,i)/(2*M_PI));
-
-                // Copy Ionize->new_electrons(i) in electron_species->particles at position electron_species->bmin[ibin]
-                Ionize->new_electrons.cp_particle(i, (*electron_species->particles), electron_species->bmin[ibin] );
-                                
-                // Update bins status
-                // (ugly update, memory is allocated anywhere, OK with vectors per particles parameters)
-                electron_species->bmax[ibin]++;
-                DEBUG("e- " << i << " to bin " << ibin << " (" <<bmin.size() << "," <<bmax.size()<<")" );
-                for (unsigned int ii=ibin+1; ii<bmin.size(); ii++) {
-                    electron_species->bmin[ii]++;
-                    electron_species->bmax[ii]++;
-                }
-            }
-            
-            // if (Ionize->new_electrons.size())
-            //      DEBUG("number of electrons " << electron_species->(*particles).size() << " " << );
-            Ionize->new_electrons.clear();
-        }
+        // Move the electrons created by ionization in the bins of the electron species
+        if (Ionize)
+            electron_species->insertParticlesInBins( Ionize->new_electrons, patch );
     }
     else { // immobile particle (at the moment only project density)
         if ( diag_flag &&(!(*particles).isTest)){
-            double* b_rho=nullptr;
+            field_real* b_rho=nullptr;
             for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin ++) { //Loop for projection on buffer_proj
 
                 if (nDim_field==2)
@@ -561,6 +504,113 @@ void Species::dynamics(double time_dual, unsigned int ispec, ElectroMagn* EMfiel
 }//END dynamic
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Same as dynamics, called by all the threads of the team : the bins of the patch are distributed among the threads,
+// each thread projecting in its private copy of the densities, the copies being then summed in the patch arrays
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::dynamics_shared(double time_dual, unsigned int ispec, ElectroMagn* EMfields, Projector* Proj,
+                              Params &params, bool diag_flag, PartWalls* partWalls, Patch* patch, SmileiMPI* smpi)
+{
+    if (time_dual<=time_frozen) {
+        #pragma omp single
+        dynamics(time_dual, ispec, EMfields, patch->Interp, Proj, params, diag_flag, partWalls, patch, smpi);
+        return;
+    }
+    
+    int ithread;
+    #ifdef _OPENMP
+        ithread = omp_get_thread_num();
+    #else
+        ithread = 0;
+    #endif
+    
+    // The interpolators store the coefficients of the current particle : one per thread, kept by the patch
+    Interpolator* Interp = patch->thread_Interp[ithread];
+    
+    std::vector<int> exchange_list;
+    double nrj_lost(0.);
+    unsigned int out_of_bin(0), unsorted(0);
+    
+    #pragma omp single
+    clearExchList();
+    
+    smpi->dynamics_resize(ithread, nDim_particle, dynamics_block_size>0 ? dynamics_block_size : bmax.back());
+    if (!(*particles).isTest)
+        Proj->open_thread_tile(EMfields, smpi, ithread, diag_flag, ispec);
+    
+    #pragma omp for schedule(runtime)
+    for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin++)
+        dynamics_bin(ibin, ithread, ispec, EMfields, Interp, Proj, params, diag_flag, partWalls, smpi,
+                     exchange_list, nrj_lost, out_of_bin, unsorted);
+    
+    if (!(*particles).isTest)
+        Proj->reduce_thread_tiles(EMfields, smpi, ithread, diag_flag, ispec);
+    
+    #pragma omp critical
+    {
+        indexes_of_particles_to_exchange.insert( indexes_of_particles_to_exchange.end(), exchange_list.begin(), exchange_list.end() );
+        nrj_bc_lost      += nrj_lost;
+        npart_out_of_bin += out_of_bin;
+        npart_unsorted   += unsorted;
+    }
+    #pragma omp barrier
+    
+    #pragma omp single
+    {
+        // The exchange requires increasing indices, the bins having been processed in any order
+        sort( indexes_of_particles_to_exchange.begin(), indexes_of_particles_to_exchange.end() );
+        npart_unsorted += indexes_of_particles_to_exchange.size();
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Interpolation, ionization, push, boundary conditions and projection of the particles of bin ibin
+// The particles leaving the patch are appended to exchange_list, the counters are incremented
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::dynamics_bin(unsigned int ibin, int ithread, unsigned int ispec, ElectroMagn* EMfields, Interpolator* Interp,
+                           Projector* Proj, Params &params, bool diag_flag, PartWalls* partWalls, SmileiMPI* smpi,
+                           std::vector<int> &exchange_list, double &nrj_lost, unsigned int &out_of_bin, unsigned int &unsorted)
+{
+    unsigned int iPart;
+    
+    // Copy the fields around the bin, and zero the densities of the bin, in the thread's tiles
+    if (bin_tiles) {
+        Interp->open_bin_tile(EMfields, smpi, ithread, ibin, clrw, b_dim);
+        if (!(*particles).isTest)
+            Proj->open_bin_tile(EMfields, smpi, ithread, ibin, diag_flag, b_dim, ispec);
+    }
+    
+    // Interpolation, ionization, push, boundary conditions and projection, by the kernel of the species' operators
+    (*Kernel)(this, ibin, ithread, ispec, EMfields, Interp, Proj, params, diag_flag, partWalls, smpi, exchange_list, nrj_lost);
+    
+    // Add the densities of the bin to the patch arrays
+    if (bin_tiles) {
+        Interp->close_bin_tile(smpi, ithread);
+        if (!(*particles).isTest)
+            Proj->close_bin_tile(EMfields, smpi, ithread, ibin, clrw, diag_flag, b_dim, ispec);
+    }
+    
+    // Count the particles which left the bin (but not the patch), and those out of cell order
+    double bin_min = min_loc + ibin*clrw*cell_length[0];
+    double bin_max = bin_min + clrw*cell_length[0];
+    double patch_max = min_loc + bmin.size()*clrw*cell_length[0];
+    for (iPart=bmin[ibin] ; (int)iPart<bmax[ibin]; iPart++ ) {
+        double x = (*particles).position(0,iPart);
+        if ( (x < bin_min && x >= min_loc) || (x >= bin_max && x < patch_max) )
+            out_of_bin++;
+    }
+    if (sort_by_cell && bmax[ibin] > bmin[ibin]) {
+        unsigned int previous_cell = cell_index( bmin[ibin] );
+        for (iPart=bmin[ibin]+1 ; (int)iPart<bmax[ibin]; iPart++ ) {
+            unsigned int icell = cell_index( iPart );
+            if (icell < previous_cell) unsorted++;
+            previous_cell = icell;
+        }
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For all particles of the species
 //   - increment the charge (projection)
@@ -572,7 +622,7 @@ void Species::computeCharge(unsigned int ispec, ElectroMagn* EMfields, Projector
     // calculate the particle charge
     // -------------------------------
     if ( (!(*particles).isTest) ) {
-        double* b_rho=nullptr;
+        field_real* b_rho=nullptr;
         for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin ++) { //Loop for projection on buffer_proj
             unsigned int bin_start = ibin*clrw*f_dim1*f_dim2;
             // Not for now, else rho is incremented twice. Here and dynamics. Must add restartRhoJs and manage independantly diags output
@@ -590,6 +640,27 @@ void Species::computeCharge(unsigned int ispec, ElectroMagn* EMfields, Projector
 }//END computeCharge
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Insert new particles (e.g. electrons created by ionization) at the beginning of their bin
+// All bins are shifted at once, instead of inserting the particles one by one in the middle of the arrays
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::insertParticlesInBins(Particles &new_parts, Patch* patch)
+{
+    unsigned int nPart = new_parts.size();
+    if ( nPart == 0 ) return;
+    
+    std::vector<int> part_bin( nPart );
+    int cell_start = patch->getCellStartingGlobalIndex(0) + oversize[0];
+    for ( unsigned int iPart=0 ; iPart<nPart ; iPart++ )
+        part_bin[iPart] = ( (int) (new_parts.position(0,iPart) / cell_length[0]) - cell_start ) / clrw;
+    
+    new_parts.cp_particles_in_bins( part_bin, *particles, bmin, bmax );
+    new_parts.clear();
+    
+    // New particles are put at the beginning of their bin, not in their cell
+    npart_unsorted += nPart;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Sort particles
 // ---------------------------------------------------------------------------------------------------------------------
@@ -653,79 +724,105 @@ void Species::sort_part()
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Sort particles
+// Sort particles only if needed, from the disorder measured during the push
+//   - by cell, if the fraction of particles out of cell order is above sort_threshold
+//   - by bin, if some particles changed bin (needed at each timestep to keep bmin/bmax valid)
 // ---------------------------------------------------------------------------------------------------------------------
-void Species::count_sort_part(Params &params)
+void Species::sort_particles()
 {
-    unsigned int ip, npart, ixy,tot, oc, nxy, token;
-    int ix,iy;
-    double x,y;
-
-    nxy = params.n_space[0]*params.n_space[1];
-    token = (particles == &particles_sorted[0]);
-
-    int indices[nxy];
-    npart = (*particles).size();
-    //particles_sorted = particles ;
-    particles_sorted[token].initialize(npart, *particles);
-
-    for (unsigned int i=0; i < nxy ; i++) indices[i] = 0 ;
-
-    // first loop counts the # of particles in each cell
-    for (ip=0; ip < npart; ip++)
-        {
-            x = (*particles).position(0,ip)-min_loc;
-            y = (*particles).position(1,ip)-min_loc_vec[1];
-
-            ix = floor(x * dx_inv_) ;
-            iy = floor(y * dy_inv_) ;
-
-            ixy = iy + ix*params.n_space[1];
-
+    if ( sort_by_cell && npart_unsorted > 0 && npart_unsorted > sort_threshold * (*particles).size() )
+        cell_sort_part();
+    else if ( npart_out_of_bin > 0 )
+        sort_part();
+    
+    npart_out_of_bin = 0;
+    npart_unsorted = 0;
+}
 
-            indices[ixy] ++;
+// ---------------------------------------------------------------------------------------------------------------------
+// Sort particles by cell, in 1D, 2D and 3D
+// Counting sort on the cell index (x-major, so that bins remain contiguous), then the permutation is applied in place
+// by following its cycles: no copy of the particles is needed
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::cell_sort_part()
+{
+    unsigned int npart = (*particles).size();
+    unsigned int nx = n_space[0];
+    unsigned int ny = nDim_particle > 1 ? n_space[1] : 1;
+    unsigned int nz = nDim_particle > 2 ? n_space[2] : 1;
+    unsigned int ncells = nx*ny*nz;
+    
+    if (npart == 0) {
+        for (unsigned int ibin=0; ibin < bmin.size(); ibin++)
+            bmin[ibin] = bmax[ibin] = 0;
+        return;
+    }
+    
+    // Cell index of each particle (clamped to the patch, for particles sitting exactly on its upper border)
+    sort_index.resize( npart );
+    double* position_x = &((*particles).position(0,0));
+    #pragma omp simd
+    for (unsigned int ip=0; ip < npart; ip++) {
+        int ix = floor( (position_x[ip]-min_loc) * dx_inv_ );
+        sort_index[ip] = max( 0, min( (int)nx-1, ix ) );
+    }
+    if (nDim_particle > 1) {
+        double* position_y = &((*particles).position(1,0));
+        #pragma omp simd
+        for (unsigned int ip=0; ip < npart; ip++) {
+            int iy = floor( (position_y[ip]-min_loc_vec[1]) * dy_inv_ );
+            sort_index[ip] = sort_index[ip]*ny + max( 0, min( (int)ny-1, iy ) );
         }
-
-    // second loop convert the count array in cumulative sum
-    tot=0;
-    for (unsigned int ixy=0; ixy < nxy; ixy++)
-        {
-            oc = indices[ixy];
-            indices[ixy] = tot;
-            tot += oc;
+    }
+    if (nDim_particle > 2) {
+        double* position_z = &((*particles).position(2,0));
+        #pragma omp simd
+        for (unsigned int ip=0; ip < npart; ip++) {
+            int iz = floor( (position_z[ip]-min_loc_vec[2]) * dz_inv_ );
+            sort_index[ip] = sort_index[ip]*nz + max( 0, min( (int)nz-1, iz ) );
+        }
+    }
+    
+    // Count the particles in each cell, then convert to the index of the first particle of each cell
+    sort_count.assign( ncells, 0 );
+    for (unsigned int ip=0; ip < npart; ip++)
+        sort_count[sort_index[ip]]++;
+    unsigned int tot = 0;
+    for (unsigned int icell=0; icell < ncells; icell++) {
+        unsigned int oc = sort_count[icell];
+        sort_count[icell] = tot;
+        tot += oc;
+    }
+    
+    // Bins are made of clrw slices of cells along x
+    unsigned int cells_per_bin = clrw*ny*nz;
+    for (unsigned int ibin=0; ibin < bmin.size(); ibin++) {
+        bmin[ibin] = sort_count[ibin*cells_per_bin];
+        bmax[ibin] = ibin+1 < bmin.size() ? sort_count[(ibin+1)*cells_per_bin] : npart;
+    }
+    
+    // Destination of each particle (stable within a cell)
+    for (unsigned int ip=0; ip < npart; ip++)
+        sort_index[ip] = sort_count[sort_index[ip]]++;
+    
+    // Cycle-leader permutation: each swap puts one particle at its final place
+    for (unsigned int ip=0; ip < npart; ip++) {
+        while (sort_index[ip] != ip) {
+            unsigned int dest = sort_index[ip];
+            (*particles).swap_part(ip, dest);
+            sort_index[ip]   = sort_index[dest];
+            sort_index[dest] = dest;
         }
-
-    //Bookmarking is not needed if normal sort is called before.
-    //bmin[0] = 0;    
-    //for (bin=0; bin<bmin.size()-1; bin++) { //Loop on the bins. 
-    //
-    //    bmin[bin+1] = indices[(bin+1)*params.n_space[1]*clrw] ;   
-    //    bmax[bin] = bmin[bin+1];   
-    //}
-    //bin = bmin.size()-1 ;
-    //bmax[bin] = npart;   
-
-    // last loop puts the particles and update the count array
-    for (ip=0; ip < npart; ip++) {
-        x = (*particles).position(0,ip)-min_loc;
-        y = (*particles).position(1,ip)-min_loc_vec[1];
-
-        ix = floor(x * dx_inv_) ;
-        iy = floor(y * dy_inv_) ;
-
-        ixy = iy + ix*params.n_space[1];
-
-        (*particles).overwrite_part(ip, particles_sorted[token] , indices[ixy]);
-        indices[ixy]++;
     }
-
-    particles = &particles_sorted[token] ;
-
 }
 
 
 int Species::createParticles(vector<unsigned int> n_space_to_create, Params& params, Patch *patch, int new_bin_idx)
 {
+    // Random numbers of this patch and species, different for the patches created later at the same index by the moving window
+    random.seed( params.random_seed, patch->Hindex() );
+    random.reset( Random::init_stream, speciesNumber, patch->getCellStartingGlobalIndex(0) );
+    
     // Create particles in a space starting at cell_position
     vector<double> cell_position(3,0);
     vector<double> cell_index(3,0);
@@ -971,7 +1068,7 @@ vector<double> Species::maxwellJuttner(unsigned int npoints, double temperature)
         // For each particle
         for( unsigned int i=0; i<npoints; i++ ) {
             // Pick a random number
-            U = (double)rand() / RAND_MAX;
+            U = random.uniform();
             // Calculate the inverse of F
             lnlnU = log(-log(U));
             if( lnlnU>2. ) {
@@ -1000,7 +1097,7 @@ vector<double> Species::maxwellJuttner(unsigned int npoints, double temperature)
         for( unsigned int i=0; i<npoints; i++ ) {
             do {
                 // Pick a random number
-                U = (double)rand() / RAND_MAX;
+                U = random.uniform();
                 // Calculate the inverse of H at the point log(1.-U) + H0
                 lnU = log(-log(1.-U) - H0);
                 if( lnU<-26. ) {
@@ -1016,7 +1113,7 @@ vector<double> Species::maxwellJuttner(unsigned int npoints, double temperature)
                 // Make a first guess for the value of gamma
                 gamma = temperature * invH;
                 // We use the rejection method, so we pick another random number
-                U = (double)rand() / RAND_MAX;
+                U = random.uniform();
                 // And we are done only if U < beta, otherwise we try again
             } while( U >= sqrt(1.-1./(gamma*gamma) ) );
             // Store that value of the energy
@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <string>
+#include <cmath>
+#include <algorithm>
 
 #include "Particles.h"
 #include "Params.h"
@@ -15,9 +17,11 @@
 #include "ElectroMagn.h"
 #include "Profile.h"
 #include "AsyncMPIbuffers.h"
+#include "Random.h"
 
 class ElectroMagn;
 class Pusher;
+class ParticleKernel;
 class Interpolator;
 class Projector;
 class PartBoundCond;
@@ -78,6 +82,18 @@ public:
     //! dynamics type. Possible values: "Norm" "Radiation Reaction"
     std::string dynamics_type;
     
+    //! Number of particles going at once through interpolation, push, BCs and projection (0 = whole bin, stage by stage)
+    unsigned int dynamics_block_size;
+    
+    //! Whether each bin interpolates from a tile of E and B, and projects in a tile of the densities added to the patch arrays once
+    bool bin_tiles;
+    
+    //! True if the currents are projected by the vectorized projector (stencils of a cell summed before being deposited)
+    bool vectorized_projection;
+    
+    //! Number of particles above which the bins of a patch are shared among the threads (0 = never)
+    unsigned int split_patch_threshold;
+    
     //! Time for which the species is frozen
     double time_frozen;
     
@@ -136,6 +152,16 @@ public:
     virtual void dynamics(double time, unsigned int ispec, ElectroMagn* EMfields, Interpolator* interp,
                           Projector* proj, Params &params, bool diag_flag,
                           PartWalls* partWalls, Patch* patch, SmileiMPI* smpi);
+    
+    //! Same as dynamics, the bins of the patch being shared among all the threads of the team (which must all call it)
+    void dynamics_shared(double time, unsigned int ispec, ElectroMagn* EMfields, Projector* proj, Params &params,
+                         bool diag_flag, PartWalls* partWalls, Patch* patch, SmileiMPI* smpi);
+    
+    //! Whether the bins of this patch are shared among the threads during the current step (see split_patch_threshold)
+    bool bins_shared;
+    
+    //! Whether the species has no particles in this patch when it is moved during the current step
+    bool empty;
 
     //! Method calculating the Particle charge on the grid (projection)
     virtual void computeCharge(unsigned int ispec, ElectroMagn* EMfields, Projector* Proj);
@@ -155,15 +181,21 @@ public:
     //! Maximum charge at initialization
     double max_charge;
 
+    //! Method used to insert new particles (e.g. ionization electrons) in the bins of this species, emptying new_parts
+    void insertParticlesInBins(Particles &new_parts, Patch* patch);
+    
     //! Method used to sort particles
     void sort_part();
-    void count_sort_part(Params& param);
+    //! Method used to sort particles by cell (counting sort, permutation applied in place)
+    void cell_sort_part();
+    //! Method used to sort particles only if needed: by cell if the disorder is above sort_threshold, by bin if some particles changed bin
+    void sort_particles();
 
     void updateMvWinLimits(double x_moved);
 
     //! Vector containing all Particles of the considered Species
     Particles *particles;
-    Particles particles_sorted[2];
+    Particles particles_storage;
     //std::vector<int> index_of_particles_to_exchange;
     
     //! Ionization method
@@ -180,11 +212,17 @@ public:
     unsigned int clrw; //Should divide the number of cells in X of a single MPI domain. 
     //! first and last index of each particle bin
     std::vector<int> bmin, bmax;
+    //! True if particles are sorted by cell (instead of only by bin)
+    bool sort_by_cell;
+    //! Fraction of particles out of cell order above which particles are sorted by cell
+    double sort_threshold;
     //! sub dimensions of buffers for dim > 1
     std::vector<unsigned int> b_dim;
 
     //! Oversize (copy from Params)
     std::vector<unsigned int> oversize;
+    //! Number of cells of the patch (copy from Params)
+    std::vector<unsigned int> n_space;
 
     //! MPI structure to exchange particles
     MPI_Datatype typePartSend ;
@@ -223,6 +261,8 @@ public:
         nrj_new_particles = 0;
     }
     inline void storeNRJlost( double nrj ) { nrj_mw_lost = nrj; };
+    //! Count the particles received from the neighbours (they are written at the end of their bin, not in their cell)
+    inline void addUnsortedParticles( unsigned int npart ) { npart_unsorted += npart; };
     
     inline double computeNRJ() {
         double nrj(0.);
@@ -238,6 +278,7 @@ public:
         //speciesSize *= getNbrOfParticles();
         int speciesSize(0);
         speciesSize += particles->double_prop.size()*sizeof(double);
+        speciesSize += particles->real_prop.size()*sizeof(particle_real);
         speciesSize += particles->short_prop.size()*sizeof(short);
         speciesSize += particles->uint_prop.size()*sizeof(unsigned int );
         speciesSize *= getParticlesCapacity();
@@ -257,11 +298,32 @@ public:
     
     //! Particles pusher (change momentum & change position)
     Pusher* Push;
+    
+    //! Random numbers of the species in this patch (stream of the initialization, then of each timestep)
+    Random random;
+    
+    //! Particle loop of dynamics_bin, instantiated for the interpolator, projector and pusher of the species
+    ParticleKernel* Kernel;
 
     //! Moving window boundary conditions managment
     void disableXmax();
     //! Moving window boundary conditions managment
     void setXminBoundaryCondition();
+    
+    //! Index of the cell of particle ipart in the patch, x-major, as ordered by cell_sort_part
+    inline unsigned int cell_index( unsigned int ipart ) {
+        int ix = std::floor( ((*particles).position(0,ipart)-min_loc) * dx_inv_ );
+        unsigned int icell = std::max( 0, std::min( (int)n_space[0]-1, ix ) );
+        if (nDim_particle > 1) {
+            int iy = std::floor( ((*particles).position(1,ipart)-min_loc_vec[1]) * dy_inv_ );
+            icell = icell*n_space[1] + std::max( 0, std::min( (int)n_space[1]-1, iy ) );
+        }
+        if (nDim_particle > 2) {
+            int iz = std::floor( ((*particles).position(2,ipart)-min_loc_vec[2]) * dz_inv_ );
+            icell = icell*n_space[2] + std::max( 0, std::min( (int)n_space[2]-1, iz ) );
+        }
+        return icell;
+    }
 
 
 private:    
@@ -290,6 +352,22 @@ private:
     //! sub primal dimensions of fields
     unsigned int f_dim0, f_dim1, f_dim2;
     
+    //! Number of particles which changed bin during the last push (the bins need sorting if > 0)
+    unsigned int npart_out_of_bin;
+    //! Number of particles out of cell order since the last sort (estimated during the push, ionization and exchange)
+    unsigned int npart_unsorted;
+    
+    //! Move the particles of bin ibin and project their currents (the particles leaving the patch are listed in exchange_list)
+    void dynamics_bin(unsigned int ibin, int ithread, unsigned int ispec, ElectroMagn* EMfields, Interpolator* Interp,
+                      Projector* Proj, Params &params, bool diag_flag, PartWalls* partWalls, SmileiMPI* smpi,
+                      std::vector<int> &exchange_list, double &nrj_lost, unsigned int &out_of_bin, unsigned int &unsorted);
+    
+    
+    //! Cell of each particle, then its destination, during cell_sort_part
+    std::vector<unsigned int> sort_index;
+    //! Number of particles per cell, then first index of each cell, during cell_sort_part
+    std::vector<unsigned int> sort_count;
+    
     //! Accumulate nrj lost with bc
     double nrj_bc_lost;
     //! Accumulate nrj lost with moving window
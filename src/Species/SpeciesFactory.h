@@ -75,6 +75,20 @@ public:
         
         PyTools::extract("c_part_max",thisSpecies->c_part_max,"Species",ispec);
         
+        PyTools::extract("dynamics_block_size",thisSpecies->dynamics_block_size,"Species",ispec);
+        
+        PyTools::extract("bin_tiles",thisSpecies->bin_tiles,"Species",ispec);
+        
+        std::string projection_mode("scalar");
+        PyTools::extract("projection_mode", projection_mode, "Species", ispec);
+        if (projection_mode == "vectorized") {
+            thisSpecies->vectorized_projection = true;
+        } else if (projection_mode != "scalar") {
+            ERROR("For species '" << species_type << "' unknown projection_mode: " << projection_mode << " (must be 'scalar' or 'vectorized')");
+        }
+        
+        PyTools::extract("split_patch_threshold",thisSpecies->split_patch_threshold,"Species",ispec);
+        
         if( !PyTools::extract("mass",thisSpecies->mass ,"Species",ispec) ) {
             ERROR("For species '" << species_type << "' mass not defined.");
         }
@@ -245,10 +259,27 @@ public:
             ERROR("For species '" << species_type << "' test & ionized is currently impossible");
         }
         
+        // Ionization projects directly on the patch arrays, and creates electrons in a shared buffer
+        if (thisSpecies->ionization_model!="none" && thisSpecies->split_patch_threshold>0) {
+            ERROR("For species '" << species_type << "' split_patch_threshold is not available with ionization");
+        }
+        
         // Find out whether this species is tracked
         TimeSelection track_timeSelection( PyTools::extract_py("track_every", "Species", ispec), "Track" );
         thisSpecies->particles->tracked = ! track_timeSelection.isEmpty();
         
+        // Extract the way particles are sorted
+        std::string sort_mode("bins");
+        PyTools::extract("sort_mode", sort_mode, "Species", ispec);
+        if (sort_mode == "cells") {
+            thisSpecies->sort_by_cell = true;
+        } else if (sort_mode != "bins") {
+            ERROR("For species '" << species_type << "' unknown sort_mode: " << sort_mode << " (must be 'bins' or 'cells')");
+        }
+        PyTools::extract("sort_threshold", thisSpecies->sort_threshold, "Species", ispec);
+        if (thisSpecies->sort_threshold < 0. || thisSpecies->sort_threshold > 1.)
+            ERROR("For species '" << species_type << "' sort_threshold must be between 0 and 1");
+        
         // Create the particles
         if (!params.restart) {
             // does a loop over all cells in the simulation
@@ -256,6 +287,10 @@ public:
             thisSpecies->createParticles(params.n_space, params, patch, 0 );
             
         }
+        else {
+            // The particles are read later from the checkpoint, but the exchange buffers need their properties
+            thisSpecies->particles->initialize( 0, params.nDim_particle );
+        }
         
         thisSpecies->initOperators(params, patch);
         
@@ -276,6 +311,10 @@ public:
         // Copy members
         newSpecies->species_type          = species->species_type;
         newSpecies->dynamics_type         = species->dynamics_type;
+        newSpecies->dynamics_block_size   = species->dynamics_block_size;
+        newSpecies->bin_tiles             = species->bin_tiles;
+        newSpecies->vectorized_projection = species->vectorized_projection;
+        newSpecies->split_patch_threshold = species->split_patch_threshold;
         newSpecies->speciesNumber         = species->speciesNumber;
         newSpecies->initPosition_type     = species->initPosition_type;
         newSpecies->initMomentum_type     = species->initMomentum_type;
@@ -308,6 +347,8 @@ public:
         newSpecies->temperatureProfile[1] = new Profile(species->temperatureProfile[1]);
         newSpecies->temperatureProfile[2] = new Profile(species->temperatureProfile[2]);
         newSpecies->max_charge            = species->max_charge;
+        newSpecies->sort_by_cell          = species->sort_by_cell;
+        newSpecies->sort_threshold        = species->sort_threshold;
         
         newSpecies->particles->isTest              = species->particles->isTest;
         newSpecies->particles->tracked             = species->particles->tracked;
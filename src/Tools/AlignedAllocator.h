@@ -0,0 +1,53 @@
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+//! Size in bytes of the alignment of the particle/buffer arrays (one cache line, one AVX-512 register)
+#define SMILEI_ALIGNMENT 64
+
+//! STL allocator returning memory aligned on N bytes
+//! Used so that the arrays processed in the vectorized loops (pusher, interpolators, projectors) start on a cache line
+template<typename T, std::size_t N = SMILEI_ALIGNMENT>
+class AlignedAllocator
+{
+public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, N> other;
+    };
+
+    AlignedAllocator() {}
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, N>&) {}
+
+    pointer allocate(size_type n) {
+        if (n==0) return NULL;
+        void* p = NULL;
+        if ( posix_memalign( &p, N, n*sizeof(T) ) != 0 )
+            throw std::bad_alloc();
+        return static_cast<pointer>(p);
+    }
+
+    void deallocate(pointer p, size_type) {
+        free(p);
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, N>&) const { return true;  }
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, N>&) const { return false; }
+
+};
+
+#endif
@@ -9,6 +9,20 @@
 #include <hdf5.h>
 #include <string>
 
+//! HDF5 type of the particle momenta and weights (see particle_real in Particles.h)
+#ifdef __SINGLE_PARTICLES
+#define H5T_NATIVE_PARTICLE_REAL H5T_NATIVE_FLOAT
+#else
+#define H5T_NATIVE_PARTICLE_REAL H5T_NATIVE_DOUBLE
+#endif
+
+//! HDF5 type of the fields (see field_real in Tools.h)
+#ifdef __SINGLE_FIELDS
+#define H5T_NATIVE_FIELD_REAL H5T_NATIVE_FLOAT
+#else
+#define H5T_NATIVE_FIELD_REAL H5T_NATIVE_DOUBLE
+#endif
+
 //! HDF5 help functions
 class H5 {
     
@@ -229,8 +243,8 @@ class H5 {
     }
     
     //! template to read generic 1d vector
-    template<class T>
-    static void getVect(hid_t locationId, std::string vect_name, std::vector<T> &vect, hid_t type, bool resizeVect=false) {
+    template<class T, class A>
+    static void getVect(hid_t locationId, std::string vect_name, std::vector<T,A> &vect, hid_t type, bool resizeVect=false) {
         hid_t did = H5Dopen(locationId, vect_name.c_str(), H5P_DEFAULT);
         hid_t sid = H5Dget_space(did);
         int sdim = H5Sget_simple_extent_ndims(sid);
@@ -0,0 +1,103 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class Random: counter-based random number generator (Philox4x32-10, Salmon et al., SC'11)
+//! Each number is a function of a key (random_seed and patch), a stream (usage and timestep) and a counter only,
+//! so that the results depend neither on the order in which the patches are processed nor on the number of threads
+//  --------------------------------------------------------------------------------------------------------------------
+class Random {
+public:
+    //! Usages of the streams (stored in the high bits of the first word of the stream)
+    enum { init_stream = 1, dynamics_stream = 2, collisions_stream = 3 };
+
+    Random() {
+        seed( 0, 0 );
+        reset( 0, 0 );
+    }
+
+    //! Set the key of the generator (random_seed of the namelist and index of the patch)
+    inline void seed( uint32_t key0, uint32_t key1 ) {
+        key_[0] = key0;
+        key_[1] = key1;
+    }
+
+    //! Start the stream of a usage (e.g. collisions_stream and the number of the collisions object)
+    //! at timestep step: the sequence of uniform() restarts from its first number
+    inline void reset( uint32_t usage, uint32_t number, uint32_t step ) {
+        reset( (usage<<24) | number, step );
+    }
+    inline void reset( uint32_t stream0, uint32_t stream1 ) {
+        stream_[0] = stream0;
+        stream_[1] = stream1;
+        counter_ = 0;
+        ibuffer_ = 2;
+    }
+
+    //! Next number of the stream, uniform in [0,1)
+    inline double uniform() {
+        if ( ibuffer_ == 2 ) {
+            block( counter_++, 0, buffer_ );
+            ibuffer_ = 0;
+        }
+        return buffer_[ibuffer_++];
+    }
+
+    //! Next n numbers of the stream (same sequence as n calls of uniform()):
+    //! the blocks of 2 numbers being independent, the main loop vectorizes
+    inline void uniform( double* u, int n ) {
+        int i = 0;
+        while ( i<n && ibuffer_<2 )
+            u[i++] = buffer_[ibuffer_++];
+        int nblocks = (n-i)/2;
+        uint32_t counter = counter_;
+        double* v = u+i;
+        #pragma omp simd
+        for ( int b=0 ; b<nblocks ; b++ )
+            block( counter+b, 0, &v[2*b] );
+        counter_ += nblocks;
+        i += 2*nblocks;
+        if ( i<n )
+            u[i] = uniform();
+    }
+
+    //! Number draw of item index of the stream (e.g. a particle), uniform in [0,1)
+    //! It does not depend on the other draws, so that the items can be processed concurrently and in any order
+    inline double uniform( uint32_t index, uint32_t draw ) const {
+        double u[2];
+        block( index, draw+1, u );
+        return u[0];
+    }
+
+private:
+    //! Philox4x32-10 bijection of the counter (c0, c1, stream_), converted to 2 numbers in [0,1) with 53 random bits
+    inline void block( uint32_t c0, uint32_t c1, double* u ) const {
+        uint32_t x0 = c0, x1 = c1, x2 = stream_[0], x3 = stream_[1];
+        uint32_t k0 = key_[0], k1 = key_[1];
+        for ( int round=0 ; round<10 ; round++ ) {
+            uint64_t p0 = (uint64_t)0xD2511F53 * x0;
+            uint64_t p1 = (uint64_t)0xCD9E8D57 * x2;
+            x0 = (uint32_t)(p1>>32) ^ x1 ^ k0;
+            x1 = (uint32_t) p1;
+            x2 = (uint32_t)(p0>>32) ^ x3 ^ k1;
+            x3 = (uint32_t) p0;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        const double two_pow_m53 = 1.0/9007199254740992.0;
+        u[0] = (double)( ( ((uint64_t)x0<<32) | x1 ) >> 11 ) * two_pow_m53;
+        u[1] = (double)( ( ((uint64_t)x2<<32) | x3 ) >> 11 ) * two_pow_m53;
+    }
+
+    uint32_t key_[2];
+    uint32_t stream_[2];
+    //! Index of the next block of the sequence of uniform()
+    uint32_t counter_;
+    //! Numbers of the current block, and index of the next one to be returned
+    double buffer_[2];
+    int ibuffer_;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef SHAPEFUNCTION_H
+#define SHAPEFUNCTION_H
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class ShapeFunction: coefficients of the shape functions of the macro-particles on the grid nodes,
+//! shared by the interpolators and the projectors of the same order
+//  --------------------------------------------------------------------------------------------------------------------
+class ShapeFunction
+{
+public:
+    //! Quartic B-spline (4th order): coefficients on the 5 nodes around the nearest node, delta being the normalized
+    //! distance to this node (coefficient of node i stored at coeff[i*stride])
+    static inline void quartic( double delta, double* coeff, int stride ) {
+        double delta2 = delta*delta;
+        double delta3 = delta2*delta;
+        double delta4 = delta3*delta;
+        coeff[0]        = 1./384.   - 1./48.  * delta  + 1./16. * delta2 - 1./12. * delta3 + 1./24. * delta4;
+        coeff[  stride] = 19./96.   - 11./24. * delta  + 1./4.  * delta2 + 1./6.  * delta3 - 1./6.  * delta4;
+        coeff[2*stride] = 115./192. - 5./8.   * delta2 + 1./4.  * delta4;
+        coeff[3*stride] = 19./96.   + 11./24. * delta  + 1./4.  * delta2 - 1./6.  * delta3 - 1./6.  * delta4;
+        coeff[4*stride] = 1./384.   + 1./48.  * delta  + 1./16. * delta2 + 1./12. * delta3 + 1./24. * delta4;
+    };
+
+};
+
+#endif
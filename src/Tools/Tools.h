@@ -107,6 +107,17 @@ class Tools {
 
 
 
+//! Floating point type used to store the fields (see Field.h) and MPI type to exchange them
+//! Single precision if compiled with config=single_fields (the reductions on the fields remain in double)
+#ifdef __SINGLE_FIELDS
+typedef float  field_real;
+#define MPI_FIELD_REAL MPI_FLOAT
+#else
+typedef double field_real;
+#define MPI_FIELD_REAL MPI_DOUBLE
+#endif
+
+
 #if defined(WIN32) || defined(_WIN32)
 #define PATH_SEPARATOR "\\"
 #else
@@ -82,7 +82,76 @@ double erfinv::call(double x) {
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Deflection angle of the binary collisions
+// ---------------------------------------------------------------------------------------------------------------------
 
+// method used to load the tabulated function
+// ------------------------------------------
+void cos_chi::prepare() {
+    if (cos_chi_tab_.size()==0) {
+        
+        cos_chi_smin_ = 0.1;
+        cos_chi_smid_ = 3.;
+        cos_chi_smax_ = 6.;
+        cos_chi_n1_   = 290;
+        unsigned int n2 = 300;
+        double ds1 = (cos_chi_smid_-cos_chi_smin_)/(double)cos_chi_n1_;
+        double ds2 = (cos_chi_smax_-cos_chi_smid_)/(double)n2;
+        cos_chi_inv_ds1_ = 1./ds1;
+        cos_chi_inv_ds2_ = 1./ds2;
+        
+        cos_chi_tab_.resize( 2*(cos_chi_n1_+1+n2+1) );
+        
+        // ----------------------------------------------
+        // TABULATE 1/A AND 1-exp(-2A) ON THE TWO GRIDS
+        // (the fits of A are those of Nanbu's theory)
+        // ----------------------------------------------
+        for (unsigned int n=0; n<=cos_chi_n1_+1+n2; n++) {
+            double s, invA;
+            if (n<=cos_chi_n1_) {
+                s = cos_chi_smin_ + (double)n * ds1;
+                // the polynomial has been modified from the article in order to have a better form
+                invA = 0.00569578 +(0.95602 + (-0.508139 + (0.479139 + ( -0.12789 + 0.0238957*s )*s )*s )*s )*s;
+            } else {
+                s = cos_chi_smid_ + (double)(n-cos_chi_n1_-1) * ds2;
+                invA = exp(s)/3.;
+            }
+            cos_chi_tab_[2*n  ] = invA;
+            cos_chi_tab_[2*n+1] = -expm1( -2./invA );
+        }//n
+        
+    }//needLoad
+    
+}
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Coulomb logarithm of the binary collisions
+// ---------------------------------------------------------------------------------------------------------------------
 
+// method used to load the tabulated function
+// ------------------------------------------
+void coulomb_logarithm::prepare() {
+    if (coulomb_log_tab_.size()==0) {
+        
+        coulomb_log_xmin_   = ldexp( 1., coulomb_log_emin_ );
+        coulomb_log_xmax_   = ldexp( 1., coulomb_log_emax_ );
+        coulomb_log_inv_dm_ = ldexp( 1., -(int)(52-coulomb_log_mbits_) );
+        
+        unsigned int nm = 1 << coulomb_log_mbits_;
+        unsigned int tabSize = (coulomb_log_emax_-coulomb_log_emin_)*nm + 1;
+        coulomb_log_tab_.resize( tabSize );
+        
+        // -----------------------------------------------------
+        // TABULATE THE COULOMB LOGARITHM
+        // (nm points between consecutive powers of 2, linear in x)
+        // -----------------------------------------------------
+        for (unsigned int n=0; n<tabSize; n++) {
+            double x = ldexp( 1. + (double)(n%nm)/(double)nm, coulomb_log_emin_ + n/nm );
+            coulomb_log_tab_[n] = max( 2., 0.5*log(1.+x) );
+        }//n
+        
+    }//needLoad
+    
+}
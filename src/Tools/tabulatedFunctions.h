@@ -6,6 +6,8 @@
 #include <iomanip>
 #include <vector>
 #include <cmath>
+#include <cstring>
+#include <stdint.h>
 #include "Tools.h"
 
 
@@ -57,6 +59,138 @@ private:
 };
 
 
+//! singleton class of the deflection angle of the binary collisions, in the center-of-mass frame
+//! Technique given by Nanbu in http://dx.doi.org/10.1103/PhysRevE.55.4642
+//! and slightly modified in http://dx.doi.org/10.1063/1.4742167
+//! The fit of cos(chi) as a function of the collision parameter s and of a random number U reads
+//!     cos_chi = 1 + (1/A) log( 1 - (1-exp(-2A)) (1-U) )
+//! where A(s) is tabulated (through 1/A and 1-exp(-2A)) for 0.1 < s < 6
+
+class cos_chi
+{
+public:
+    static cos_chi& instance()
+    {
+        static cos_chi one_and_only_instance; // Guaranteed to be destroyed.
+        // Instantiated on first use.
+        return one_and_only_instance;
+    }
+    
+    //! returns the cosine of the deflection angle for a collision parameter s and a random number U in [0,1)
+    inline double call(double s, double U) {
+        if( s < cos_chi_smin_ ) {
+            if ( U<0.0001 ) U=0.0001; // ensures cos_chi > 0
+            return 1. + s*log(U);
+        }
+        if( s >= cos_chi_smax_ ) {
+            return 2.*U - 1.;
+        }
+        // linear interpolation, each side of s = cos_chi_smid_ having its own grid
+        double x;
+        if( s < cos_chi_smid_ ) {
+            x = (s-cos_chi_smin_) * cos_chi_inv_ds1_;
+        } else {
+            x = (s-cos_chi_smid_) * cos_chi_inv_ds2_ + (double)(cos_chi_n1_+1);
+        }
+        unsigned int n = (unsigned int)x;
+        double wr = x - (double)n;
+        double wl = 1. - wr;
+        const double * tab = &cos_chi_tab_[2*n];
+        double invA        = wl*tab[0] + wr*tab[2];
+        double one_minus_E = wl*tab[1] + wr*tab[3];
+        double val = 1. + invA * log1p( -one_minus_E * (1.-U) );
+        return val > -1. ? val : -1.; // the interpolation may slightly overshoot when U ~ 0
+    }
+    
+    //! needs to be called one time before using cos_chi
+    void prepare();
+    
+protected:    
+    // creator is private for singletons
+    cos_chi(){};    
+    cos_chi(cos_chi const&); // avoid implementation of this
+    void operator=(cos_chi const&); // avoid implementation of this
+
+private:    
+    
+    //! s below which cos_chi = 1 + s*log(U)
+    double cos_chi_smin_;
+    
+    //! s at which the fit of A changes (the sampling uses two grids, A being discontinuous there)
+    double cos_chi_smid_;
+    
+    //! s above which the deflection is isotropic
+    double cos_chi_smax_;
+    
+    //! number of intervals of the first grid
+    unsigned int cos_chi_n1_;
+    
+    //! inverse steps of the two grids
+    double cos_chi_inv_ds1_, cos_chi_inv_ds2_;
+    
+    //! sampled values of 1/A and 1-exp(-2A), stored by pairs
+    std::vector<double> cos_chi_tab_;
+    
+};
+
+
+//! singleton class of the Coulomb logarithm max( 2, 0.5*log(1+x) ), x being the ratio (debye length/bmin)^2
+//! The sampling follows the exponent and the first bits of the mantissa of x, so that no logarithm is computed
+
+class coulomb_logarithm
+{
+public:
+    static coulomb_logarithm& instance()
+    {
+        static coulomb_logarithm one_and_only_instance; // Guaranteed to be destroyed.
+        // Instantiated on first use.
+        return one_and_only_instance;
+    }
+    
+    //! returns the Coulomb logarithm for x = (debye length/bmin)^2
+    inline double call(double x) {
+        if( x < coulomb_log_xmin_ ) return 2.;
+        if( x >= coulomb_log_xmax_ ) return 0.5*log(x);
+        uint64_t bits;
+        memcpy( &bits, &x, sizeof(bits) );
+        // x = 2^exponent * ( 1 + mantissa/2^52 )
+        unsigned int exponent = (unsigned int)( bits >> 52 ) - 1023 - coulomb_log_emin_;
+        uint64_t mantissa = bits & 0xFFFFFFFFFFFFFull;
+        unsigned int n = ( exponent << coulomb_log_mbits_ ) + (unsigned int)( mantissa >> (52-coulomb_log_mbits_) );
+        double wr = (double)( mantissa & ( (1ull<<(52-coulomb_log_mbits_)) - 1 ) ) * coulomb_log_inv_dm_;
+        return coulomb_log_tab_[n] + wr * ( coulomb_log_tab_[n+1] - coulomb_log_tab_[n] );
+    }
+    
+    //! needs to be called one time before using coulomb_logarithm
+    void prepare();
+    
+protected:    
+    // creator is private for singletons
+    coulomb_logarithm(){};    
+    coulomb_logarithm(coulomb_logarithm const&); // avoid implementation of this
+    void operator=(coulomb_logarithm const&); // avoid implementation of this
+
+private:    
+    
+    //! number of bits of the mantissa used to sample each power of 2
+    static const unsigned int coulomb_log_mbits_ = 6;
+    
+    //! powers of 2 bounding the sampled interval
+    static const unsigned int coulomb_log_emin_ = 5;
+    static const unsigned int coulomb_log_emax_ = 64;
+    
+    //! sampled interval (below xmin, the Coulomb logarithm is 2)
+    double coulomb_log_xmin_, coulomb_log_xmax_;
+    
+    //! inverse of the remaining bits of the mantissa
+    double coulomb_log_inv_dm_;
+    
+    //! sampled values of the Coulomb logarithm
+    std::vector<double> coulomb_log_tab_;
+    
+};
+
+
 #endif
 
 